@@ -128,6 +128,7 @@ private:
 
 class CBinaryReader : public Internal::CReader
 {
+public:
     CBinaryReader (const CPath & filepath);
     ~CBinaryReader ();
     
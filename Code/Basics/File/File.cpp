@@ -238,7 +238,7 @@ TArray<byte> CBinaryReader::ReadAll ()
     const uint bytes = CFile::Bytes();
 
     TArray<byte> out;
-    out.Reserve(bytes);
+    out.Resize(bytes);
 
     Seek(0);
     fread((void *)out.Ptr(), 1, bytes, (FILE *)m_file);
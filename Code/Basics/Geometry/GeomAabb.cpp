@@ -30,10 +30,9 @@ Aabb2::Aabb2 (const Point2 & center, const Vector2 & halfExtent) :
 }
 
 //=============================================================================
-TArray<Point2> Aabb2::GetPoints() const
+TInlineArray<Point2, 4> Aabb2::GetPoints() const
 {
-    TArray<Point2> out;
-    out.Reserve(4);
+    TInlineArray<Point2, 4> out;
 
     out.Add(min);
     out.Add(Point2(min.x, max.y));
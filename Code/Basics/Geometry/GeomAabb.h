@@ -4,6 +4,7 @@
 #define GEOMAABB_H
 
 #include "Core/Containers/CntArray.h"
+#include "Core/Containers/CntInlineArray.h"
 
 //*****************************************************************************
 //
@@ -22,7 +23,7 @@ public:
     inline Aabb2 & operator+= (const Point2 & rhs);
 
     inline float32 ProjectedRadiusAlongVector (const Vector2 & v) const;
-    TArray<Point2> GetPoints() const;
+    TInlineArray<Point2, 4> GetPoints() const;
 
     static const Aabb2 Null;
     static const Aabb2 Infinity;
@@ -45,13 +45,12 @@ Obb2::Obb2 (
 }
 
 //=============================================================================
-TArray<Point2> Obb2::GetPoints () const
+TInlineArray<Point2, 4> Obb2::GetPoints () const
 {
     const Vector2 baseX = u[0] * extent.x;
     const Vector2 baseY = u[1] * extent.y;
 
-    TArray<Point2> out;
-    out.Reserve(4);
+    TInlineArray<Point2, 4> out;
     out.Add( baseX + baseY + center);
     out.Add( baseX - baseY + center);
     out.Add(-baseX - baseY + center);
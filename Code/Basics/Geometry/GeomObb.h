@@ -18,7 +18,7 @@ public:
 
     inline float32 ProjectedRadiusAlongVector (const Vector2 & v) const;
     inline Matrix23 GetMatrix () const;
-    TArray<Point2> GetPoints () const;
+    TInlineArray<Point2, 4> GetPoints () const;
 
     Point2 center;      //!< Center of the box
     Vector2 extent;     //!< Positive halfwidth extents of Obb3 along each local axis
@@ -7,9 +7,15 @@
 //*****************************************************************************
 
 //=============================================================================
-Polygon2::Polygon2 (const TArray<Point2> & points) :
-    points(points)
+Polygon2::Polygon2 (const TArray<Point2> & points)
 {
+    this->points.Add(points.Ptr(), points.Count());
+}
+
+//=============================================================================
+Polygon2::Polygon2 (const Point2 points[], uint count)
+{
+    this->points.Add(points, count);
 }
 
 //=============================================================================
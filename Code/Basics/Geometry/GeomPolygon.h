@@ -8,8 +8,12 @@
 class Polygon2
 {
 public:
+    // Most polygons are boxes or the clipped result of two boxes
+    typedef TInlineArray<Point2, 8> PointArray;
+
     Polygon2 () = default;
     Polygon2 (const TArray<Point2> & points);
+    Polygon2 (const Point2 points[], uint count);
 
     float32 ComputeArea () const;
     Point2 ComputeCentroid () const;
@@ -21,6 +25,6 @@ public: //
     static Polygon2 Clip (const Polygon2 & subjectPoly, const Polygon2 & clipPoly);
 
 public: // data
-    TArray<Point2> points;
+    PointArray points;
 };
 
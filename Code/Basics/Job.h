@@ -0,0 +1,278 @@
+#ifndef BASICS_JOB_H
+#define BASICS_JOB_H
+
+#include <atomic>
+
+#include "Basics/Thread.h"
+
+namespace Job
+{
+
+//*****************************************************************************
+//
+// Types
+//
+//*****************************************************************************
+
+typedef std::function<void ()> FJob;
+typedef void (* FContinuation)(void * context);
+
+
+
+//*****************************************************************************
+//
+// CCounter
+//
+// Number of jobs in a batch that have yet to finish. Pass the same counter to
+// Run for every job in the batch, then Wait on it, or have OnDone call back
+// when the batch finishes instead of holding a thread in Wait.
+//
+//*****************************************************************************
+
+class CCounter
+{
+public:
+    CCounter () : m_pending(0), m_continuation(null), m_context(null) {}
+
+    bool IsDone () const { return m_pending.load(std::memory_order_acquire) == 0; }
+    uint Pending () const { return m_pending.load(std::memory_order_relaxed) & ~CONTINUATION; }
+
+    void Add (uint count = 1) { m_pending.fetch_add(count, std::memory_order_relaxed); }
+    inline void Release ();
+
+    // Calls fn(context) once, on the thread whose Release brings the count to
+    // zero, or on this thread if it is zero already. Only one continuation
+    // may be waiting at a time, and fn should be short: it runs inside
+    // whichever job finished last.
+    inline void OnDone (FContinuation fn, void * context);
+
+private:
+    CLASS_NO_COPY(CCounter);
+
+    // Set in m_pending while a continuation waits, so the counter does not
+    // read as done, and may not be destroyed, until the continuation is
+    // taken. The last Release never touches the counter after that.
+    static const uint CONTINUATION = 1u << 31;
+
+    std::atomic<uint> m_pending;
+    FContinuation     m_continuation;
+    void *            m_context;
+};
+
+
+
+//*****************************************************************************
+//
+// Scheduler
+//
+// One pool of worker threads shared by every system. Each worker, and the
+// thread that called Initialize, owns a Chase-Lev deque: it pushes and pops
+// its own jobs at the bottom, LIFO, for cache locality, while idle threads
+// steal from the top of other deques. Jobs submitted from any other thread go
+// through a shared queue. Idle workers sleep until new work is submitted.
+//
+// Wait never blocks while there is work anywhere: the waiting thread runs its
+// own jobs and steals others until the counter reaches zero, so jobs may wait
+// on jobs they submit without starving the pool.
+//
+// Before Initialize, and after Uninitialize, Run executes jobs inline.
+//
+// By default there is one worker per physical core, less one for the calling
+// thread, each pinned to its core. Workers are grouped by NUMA node and job
+// records come from an allocator for the submitting thread's node.
+//
+//*****************************************************************************
+
+// workerCount of zero picks one worker per physical core, less one for the
+// calling thread. Workers are only pinned when each can have a core to itself.
+void Initialize (uint workerCount = 0);
+void Uninitialize ();
+
+uint WorkerCount ();
+uint ThreadCount ();    // Workers plus the thread that called Initialize
+sint ThreadIndex ();    // 0 for the Initialize thread, 1..WorkerCount for workers, -1 otherwise
+
+uint NodeCount ();      // NUMA nodes the scheduler distinguishes
+uint ThreadNode ();     // NUMA node of the calling thread, 0 for threads the scheduler does not own
+
+void Run (FJob job, CCounter * counter = null);
+void Wait (CCounter * counter);
+
+bool IsInJob ();        // True while the calling thread is running a job
+
+
+
+//*****************************************************************************
+//
+// CScope
+//
+// Marks work the calling thread does inline on behalf of a job, such as its
+// own share of a ParallelFor, so that IsInJob holds for it as it does for the
+// rest of the work.
+//
+//*****************************************************************************
+
+class CScope
+{
+public:
+    CScope ();
+    ~CScope ();
+
+private:
+    CLASS_NO_COPY(CScope);
+};
+
+
+
+//*****************************************************************************
+//
+// CTopLevelScope
+//
+// The opposite of CScope: marks a job that stands for top level work, such
+// as a task graph node, so IsInJob is false inside it and a ParallelFor there
+// spreads over the pool instead of running serially.
+//
+//*****************************************************************************
+
+class CTopLevelScope
+{
+public:
+    CTopLevelScope ();
+    ~CTopLevelScope ();
+
+private:
+    CLASS_NO_COPY(CTopLevelScope);
+
+    uint m_depth;
+};
+
+
+
+//*****************************************************************************
+//
+// ParallelFor
+//
+// Calls fn(index) for every index in [first, term). The range is cut into
+// chunks of grainSize indices, or about eight per thread when grainSize is
+// zero, and one job per thread claims chunks until none are left, so uneven
+// chunks balance out. The calling thread takes part and returns once every
+// index is done.
+//
+// Runs serially when called from inside a job: the outer loop already keeps
+// every thread busy, and nesting would only add scheduling overhead. Task
+// graph nodes count as top level, see CTopLevelScope.
+//
+//*****************************************************************************
+
+template <typename F>
+void ParallelFor (uint first, uint term, uint grainSize, F fn);
+
+
+
+//*****************************************************************************
+//
+// ParallelReduce
+//
+// Folds fn(acc, index) over [first, term) and returns the combined result.
+// Chunking is as for ParallelFor. Each participating thread accumulates into
+// its own copy of identity, which doubles as per-worker scratch space, and the
+// copies are merged with combine(a, b) at the end. Because chunks go to
+// whichever thread claims them first, combine must be associative and
+// commutative for the result to be repeatable.
+//
+//*****************************************************************************
+
+template <typename T, typename F, typename C>
+T ParallelReduce (uint first, uint term, uint grainSize, const T & identity, F fn, C combine);
+
+
+
+//*****************************************************************************
+//
+// CTaskGraph
+//
+// A fixed set of stages, such as the system updates that make up a frame,
+// run together on the job system. Each node declares the resources it reads
+// and writes as bits in a mask, and depends on every earlier node that writes
+// something it touches or reads something it writes. Nodes that share no
+// resource run in parallel, so declaration order only matters between stages
+// that share data:
+//
+//      enum : uint64
+//      {
+//          RES_TIME    = 1 << 0,
+//          RES_BODIES  = 1 << 1,
+//          RES_PATHS   = 1 << 2,
+//          RES_ENTITY  = 1 << 3,
+//      };
+//
+//      graph.Add("Time",    Time::Update,                 0,                      RES_TIME);
+//      graph.Add("Physics", [&] { physics->Update(dt); }, RES_TIME,               RES_BODIES);
+//      graph.Add("Pathing", [&] { pathing->Update(); },   RES_TIME,               RES_PATHS);
+//      graph.Add("Entity",  [&] { UpdateEntities(); },    RES_BODIES | RES_PATHS, RES_ENTITY);
+//
+// Here physics and pathing overlap, and entities wait for both. Run resets
+// the calling thread's frame arena if a frame has started since it last did,
+// so it must not be called while that thread holds frame temporaries.
+// Nodes run as top level work, so a ParallelFor inside one still spreads
+// over the pool.
+//
+// Build the graph once and Run it every frame. Run times every node, then
+// finds the critical path: the chain of dependent nodes with the largest
+// total duration. The frame can never take less time than that chain however
+// many threads there are, and speeding up nodes off it gains nothing.
+//
+//*****************************************************************************
+
+class CTaskGraph
+{
+public:
+    CTaskGraph ();
+    ~CTaskGraph ();
+
+    // Returns the new node's id. Ids are handed out in declaration order.
+    // name is kept, not copied, and each run is recorded under it by the
+    // profiler, so as with PROFILE_SCOPE it must be a literal or otherwise
+    // live for the rest of the program.
+    uint Add (const char name[], FJob fn, uint64 reads, uint64 writes);
+
+    // Orders two nodes that share no declared resource; before must be
+    // declared first
+    void AddDependency (uint node, uint before);
+
+    void Clear ();
+
+    // Runs every node once and returns when all are done. The calling thread
+    // helps, as with Wait.
+    void Run ();
+
+    uint                 NodeCount () const { return m_nodes.Count(); }
+    const char *         NodeName (uint node) const;
+    Time::Delta          NodeDuration (uint node) const;     // From the last Run
+
+    Time::Delta          Duration () const { return m_duration; }    // Wall time of the last Run
+    Time::Delta          CriticalPathDuration () const { return m_criticalDuration; }
+    const TArray<uint> & CriticalPath () const { return m_criticalPath; }   // Node ids, first to last
+
+private:
+    CLASS_NO_COPY(CTaskGraph);
+
+    struct Node;
+
+    void Launch (uint node);
+    void Execute (uint node);
+    void FindCriticalPath ();
+
+    TArray<Node *> m_nodes;
+    CCounter       m_counter;
+
+    Time::Delta    m_duration;
+    Time::Delta    m_criticalDuration;
+    TArray<uint>   m_criticalPath;
+};
+
+} // namespace Job
+
+#include "Job/Job.inl"
+
+#endif // BASICS_JOB_H
@@ -0,0 +1,527 @@
+#include "JobPch.h"
+
+namespace Job
+{
+
+//*****************************************************************************
+//
+// Constants
+//
+//*****************************************************************************
+
+const uint DEQUE_CAPACITY    = 4096;   // Per thread, power of two
+const uint INJECTED_CAPACITY = 4096;
+const uint MAX_NODES         = 8;      // Nodes past this share allocators
+
+
+
+//*****************************************************************************
+//
+// JobData
+//
+//*****************************************************************************
+
+namespace
+{
+
+struct JobData
+{
+    FJob       fn;
+    CCounter * counter;
+    uint       node;        // Allocator it came from
+};
+
+} // namespace
+
+
+
+//*****************************************************************************
+//
+// CDeque
+//
+// Chase-Lev work-stealing deque with the C11 orderings of Le et al., "Correct
+// and Efficient Work-Stealing for Weak Memory Models". The owner pushes and
+// pops at the bottom; any thread may steal from the top. Fixed capacity:
+// Push fails when full and the caller finds the job another home.
+//
+//*****************************************************************************
+
+class CDeque
+{
+public:
+    CDeque ();
+
+    bool      Push (JobData * job);     // Owner only
+    JobData * Pop ();                   // Owner only
+    JobData * Steal ();                 // Any thread
+
+    bool      IsEmptyApprox () const;
+
+private:
+    CLASS_NO_COPY(CDeque);
+
+    alignas(CACHE_LINE_SIZE) std::atomic<sint64>    m_top;
+    alignas(CACHE_LINE_SIZE) std::atomic<sint64>    m_bottom;
+    alignas(CACHE_LINE_SIZE) std::atomic<JobData *> m_jobs[DEQUE_CAPACITY];
+};
+
+//=============================================================================
+CDeque::CDeque () :
+    m_top(0),
+    m_bottom(0)
+{
+    for (std::atomic<JobData *> & job : m_jobs)
+        job.store(null, std::memory_order_relaxed);
+}
+
+//=============================================================================
+bool CDeque::Push (JobData * job)
+{
+    const sint64 bottom = m_bottom.load(std::memory_order_relaxed);
+    const sint64 top    = m_top.load(std::memory_order_acquire);
+    if (bottom - top >= sint64(DEQUE_CAPACITY))
+        return false;
+
+    m_jobs[bottom & (DEQUE_CAPACITY - 1)].store(job, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+//=============================================================================
+JobData * CDeque::Pop ()
+{
+    const sint64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    sint64 top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        // Empty
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return null;
+    }
+
+    JobData * job = m_jobs[bottom & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+        // Last job, race any thieves for it
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            job = null;
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+//=============================================================================
+JobData * CDeque::Steal ()
+{
+    sint64 top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const sint64 bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+        return null;
+
+    JobData * job = m_jobs[top & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return null;    // Lost to the owner or another thief
+    return job;
+}
+
+//=============================================================================
+bool CDeque::IsEmptyApprox () const
+{
+    return m_top.load(std::memory_order_seq_cst) >= m_bottom.load(std::memory_order_seq_cst);
+}
+
+
+
+//*****************************************************************************
+//
+// CWorker
+//
+//*****************************************************************************
+
+class CWorker : public CThread
+{
+public:
+    // Unpinned workers pass NODE_ANY and take the node they start on
+    CWorker (uint index, uint node) : m_index(index), m_node(node) {}
+
+    void ThreadEnter () override;
+
+    static const uint NODE_ANY = ~0u;
+
+private:
+    uint m_index;
+    uint m_node;
+};
+
+
+
+//*****************************************************************************
+//
+// Internal State
+//
+//*****************************************************************************
+
+// Job records are allocated on the submitting thread's node, so on
+// multi-socket machines the memory a job is built in is usually local
+static TBlockAllocator<JobData, 256> s_jobAllocators[MAX_NODES];
+
+static TArray<CWorker *>        s_workers;
+static CDeque *                 s_deques;           // One per thread, indexed by ThreadIndex
+static TMpmcQueue<JobData *> *  s_injected;         // Jobs from threads without a deque
+static Semaphore *              s_wake;
+static std::atomic<uint>        s_sleeping;
+static std::atomic<bool>        s_quit;
+static uint                     s_threadCount = 1;  // Fixed while workers run
+static uint                     s_nodeCount   = 1;
+static bool                     s_isInitialized = false;
+
+static thread_local sint        s_threadIndex = -1;
+static thread_local uint32      s_stealSeed   = 0;
+static thread_local uint        s_jobDepth    = 0;
+static thread_local uint        s_threadNode  = 0;
+
+
+
+//*****************************************************************************
+//
+// Helpers
+//
+//*****************************************************************************
+
+//=============================================================================
+static void Execute (JobData * job)
+{
+    s_jobDepth++;
+    job->fn();
+    s_jobDepth--;
+
+    // A job stolen from another node goes back to its home depot; this
+    // thread never allocates there, so caching it here would strand it
+    CCounter * counter = job->counter;
+    if (job->node == s_threadNode)
+        s_jobAllocators[job->node].Delete(job);
+    else
+        s_jobAllocators[job->node].DeleteShared(job);
+
+    if (counter)
+        counter->Release();
+}
+
+//=============================================================================
+static JobData * FindJob (sint index)
+{
+    if (index >= 0)
+    {
+        if (JobData * job = s_deques[index].Pop())
+            return job;
+    }
+
+    JobData * job;
+    if (s_injected->Pop(&job))
+        return job;
+
+    // Start stealing at a random victim so thieves spread out
+    uint32 seed = s_stealSeed ? s_stealSeed : uint32(index + 2) * 2654435761u;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    s_stealSeed = seed;
+
+    const uint count = ThreadCount();
+    const uint start = seed % count;
+    for (uint i = 0; i < count; ++i)
+    {
+        const uint victim = (start + i) % count;
+        if (sint(victim) == index)
+            continue;
+
+        if (JobData * job = s_deques[victim].Steal())
+            return job;
+    }
+
+    return null;
+}
+
+//=============================================================================
+static bool HasWorkApprox ()
+{
+    if (!s_injected->IsEmptyApprox())
+        return true;
+
+    for (uint i = 0, count = ThreadCount(); i < count; ++i)
+    {
+        if (!s_deques[i].IsEmptyApprox())
+            return true;
+    }
+
+    return false;
+}
+
+//=============================================================================
+static void WakeWorker ()
+{
+    // Pairs with the fence in CWorker::ThreadEnter: either the sleeper sees
+    // the new job or this thread sees the sleeper
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (s_sleeping.load(std::memory_order_relaxed))
+        s_wake->Post();
+}
+
+
+
+//*****************************************************************************
+//
+// CWorker
+//
+//*****************************************************************************
+
+//=============================================================================
+void CWorker::ThreadEnter ()
+{
+    s_threadIndex = sint(m_index);
+    s_threadNode  = m_node != NODE_ANY ? m_node : Min(ThreadCurrentNumaNode(), MAX_NODES - 1);
+
+    char name[32];
+    snprintf(name, array_size(name), "Job Worker %u", m_index);
+    Profile::SetThreadName(name);
+
+    while (!s_quit.load(std::memory_order_acquire))
+    {
+        // Between jobs nothing on this thread holds frame temporaries
+        MemFrameSync();
+
+        if (JobData * job = FindJob(m_index))
+        {
+            Execute(job);
+            continue;
+        }
+
+        s_sleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!HasWorkApprox() && !s_quit.load(std::memory_order_acquire))
+            s_wake->Wait();
+
+        s_sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+
+
+//*****************************************************************************
+//
+// Scheduler
+//
+//*****************************************************************************
+
+//=============================================================================
+void Initialize (uint workerCount)
+{
+    ASSERT(!s_isInitialized);
+
+    TArray<CpuCore> cores;
+    ThreadGetCores(&cores);
+
+    if (!workerCount)
+        workerCount = cores.Count() > 1 ? cores.Count() - 1 : 1;
+
+    // One worker per physical core, leaving the first for the calling thread.
+    // Pinned workers stay near their caches and, on multi-socket machines,
+    // their node's memory. With more workers than cores, let the OS place them.
+    const bool pin = workerCount < cores.Count();
+
+    s_deques   = new CDeque[workerCount + 1];
+    s_injected = new TMpmcQueue<JobData *>(INJECTED_CAPACITY);
+    s_wake     = new Semaphore(0);
+    s_sleeping.store(0, std::memory_order_relaxed);
+    s_quit.store(false, std::memory_order_relaxed);
+
+    s_nodeCount     = Min(ThreadNumaNodeCount(), MAX_NODES);
+    s_threadNode    = Min(ThreadCurrentNumaNode(), MAX_NODES - 1);
+    s_threadIndex   = 0;
+    s_threadCount   = workerCount + 1;
+    s_isInitialized = true;
+    Profile::SetThreadName("Main");
+
+    for (uint i = 1; i <= workerCount; ++i)
+    {
+        const uint node = pin ? Min(cores[i].node, MAX_NODES - 1) : CWorker::NODE_ANY;
+        CWorker * worker = new CWorker(i, node);
+
+        char name[32];
+        snprintf(name, array_size(name), "Job Worker %u", i);
+        worker->SetName(name);
+        if (pin)
+            worker->SetAffinity(cores[i].cpus);
+
+        s_workers.Add(worker);
+        worker->Start();
+    }
+}
+
+//=============================================================================
+void Uninitialize ()
+{
+    ASSERT(s_isInitialized);
+    ASSERT(s_threadIndex == 0);
+
+    s_quit.store(true, std::memory_order_release);
+    for (uint i = 0; i < s_workers.Count(); ++i)
+        s_wake->Post();
+
+    for (CWorker * worker : s_workers)
+        worker->Join();
+
+    // Finish anything still queued, including jobs the workers left behind
+    while (JobData * job = FindJob(0))
+        Execute(job);
+
+    for (CWorker * worker : s_workers)
+        delete worker;
+    s_workers.Clear();
+
+    delete s_wake;
+    delete s_injected;
+    delete[] s_deques;
+    s_wake     = null;
+    s_injected = null;
+    s_deques   = null;
+
+    s_threadIndex   = -1;
+    s_threadNode    = 0;
+    s_threadCount   = 1;
+    s_nodeCount     = 1;
+    s_isInitialized = false;
+    for (TBlockAllocator<JobData, 256> & allocator : s_jobAllocators)
+        allocator.Trim();
+}
+
+//=============================================================================
+uint WorkerCount ()
+{
+    return s_threadCount - 1;
+}
+
+//=============================================================================
+uint ThreadCount ()
+{
+    return s_threadCount;
+}
+
+//=============================================================================
+sint ThreadIndex ()
+{
+    return s_threadIndex;
+}
+
+//=============================================================================
+uint NodeCount ()
+{
+    return s_nodeCount;
+}
+
+//=============================================================================
+uint ThreadNode ()
+{
+    return s_threadNode;
+}
+
+//=============================================================================
+void Run (FJob fn, CCounter * counter)
+{
+    if (counter)
+        counter->Add();
+
+    const uint node = s_threadNode;
+    JobData * job = s_jobAllocators[node].New();
+    job->fn      = std::move(fn);
+    job->counter = counter;
+    job->node    = node;
+
+    if (!s_isInitialized)
+    {
+        Execute(job);
+        return;
+    }
+
+    const sint index = s_threadIndex;
+    const bool queued = (index >= 0 && s_deques[index].Push(job)) || s_injected->Push(job);
+    if (!queued)
+    {
+        // Every queue is full, the caller does the work itself
+        Execute(job);
+        return;
+    }
+
+    WakeWorker();
+}
+
+//=============================================================================
+void Wait (CCounter * counter)
+{
+    if (!counter)
+        return;
+
+    const sint index = s_threadIndex;
+    while (!counter->IsDone())
+    {
+        JobData * job = s_isInitialized ? FindJob(index) : null;
+        if (job)
+            Execute(job);
+        else
+            ThreadYield();
+    }
+}
+
+//=============================================================================
+bool IsInJob ()
+{
+    return s_jobDepth > 0;
+}
+
+
+
+//*****************************************************************************
+//
+// CScope
+//
+//*****************************************************************************
+
+//=============================================================================
+CScope::CScope ()
+{
+    s_jobDepth++;
+}
+
+//=============================================================================
+CScope::~CScope ()
+{
+    s_jobDepth--;
+}
+
+
+
+//*****************************************************************************
+//
+// CTopLevelScope
+//
+//*****************************************************************************
+
+//=============================================================================
+CTopLevelScope::CTopLevelScope () :
+    m_depth(s_jobDepth)
+{
+    s_jobDepth = 0;
+}
+
+//=============================================================================
+CTopLevelScope::~CTopLevelScope ()
+{
+    s_jobDepth = m_depth;
+}
+
+} // namespace Job
@@ -0,0 +1,196 @@
+namespace Job
+{
+
+//*****************************************************************************
+//
+// CCounter
+//
+//*****************************************************************************
+
+//=============================================================================
+void CCounter::Release ()
+{
+    // Without a continuation the decrement is the last access, since a
+    // waiter may destroy the counter as soon as it reads zero
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) != (CONTINUATION | 1))
+        return;
+
+    const FContinuation fn      = m_continuation;
+    void * const        context = m_context;
+    m_pending.store(0, std::memory_order_release);
+    fn(context);
+}
+
+//=============================================================================
+void CCounter::OnDone (FContinuation fn, void * context)
+{
+    ASSERT(fn);
+
+    m_continuation = fn;
+    m_context      = context;
+
+    const uint pending = m_pending.fetch_add(CONTINUATION, std::memory_order_acq_rel);
+    ASSERT(!(pending & CONTINUATION));
+    if (pending)
+        return;
+
+    // Already done, so no Release is coming to take it
+    m_pending.store(0, std::memory_order_release);
+    fn(context);
+}
+
+
+
+namespace Internal
+{
+
+//*****************************************************************************
+//
+// Chunking
+//
+//*****************************************************************************
+
+const uint CHUNKS_PER_THREAD = 8;
+
+//=============================================================================
+inline uint GrainSize (uint count, uint grainSize)
+{
+    if (grainSize)
+        return grainSize;
+
+    const uint chunks = ThreadCount() * CHUNKS_PER_THREAD;
+    return (count - 1) / chunks + 1;
+}
+
+//=============================================================================
+// Per thread state on a cache line of its own, so threads updating their own
+// copy never invalidate each other's
+template <typename T>
+struct alignas(CACHE_LINE_SIZE) Padded
+{
+    Padded (const T & value) : value(value) {}
+
+    T value;
+};
+
+} // namespace Internal
+
+
+
+//*****************************************************************************
+//
+// ParallelFor
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename F>
+void ParallelFor (uint first, uint term, uint grainSize, F fn)
+{
+    if (first >= term)
+        return;
+
+    const uint count = term - first;
+    const uint grain  = Internal::GrainSize(count, grainSize);
+    const uint chunks = (count - 1) / grain + 1;
+    const uint jobs   = Min(ThreadCount(), chunks);
+    if (jobs < 2 || IsInJob())
+    {
+        for (uint i = first; i < term; ++i)
+            fn(i);
+        return;
+    }
+
+    std::atomic<uint> next(0);
+    auto work = [&]() {
+        for (;;)
+        {
+            const uint chunk = next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks)
+                break;
+
+            const uint start = first + chunk * grain;
+            const uint stop  = term - start > grain ? start + grain : term;
+            for (uint i = start; i < stop; ++i)
+                fn(i);
+        }
+    };
+
+    CCounter counter;
+    for (uint i = 1; i < jobs; ++i)
+        Run(work, &counter);
+
+    {
+        CScope scope;
+        work();
+    }
+    Wait(&counter);
+}
+
+
+
+//*****************************************************************************
+//
+// ParallelReduce
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, typename F, typename C>
+T ParallelReduce (uint first, uint term, uint grainSize, const T & identity, F fn, C combine)
+{
+    if (first >= term)
+        return identity;
+
+    const uint count = term - first;
+    const uint grain  = Internal::GrainSize(count, grainSize);
+    const uint chunks = (count - 1) / grain + 1;
+    const uint jobs   = Min(ThreadCount(), chunks);
+    if (jobs < 2 || IsInJob())
+    {
+        T acc = identity;
+        for (uint i = first; i < term; ++i)
+            fn(acc, i);
+        return acc;
+    }
+
+    TArray<Internal::Padded<T>> partials;
+    partials.Reserve(jobs);
+    for (uint i = 0; i < jobs; ++i)
+        partials.Add(Internal::Padded<T>(identity));
+
+    std::atomic<uint> next(0);
+    auto work = [&](T & acc) {
+        for (;;)
+        {
+            const uint chunk = next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks)
+                break;
+
+            const uint start = first + chunk * grain;
+            const uint stop  = term - start > grain ? start + grain : term;
+            for (uint i = start; i < stop; ++i)
+                fn(acc, i);
+        }
+    };
+
+    CCounter counter;
+    for (uint i = 1; i < jobs; ++i)
+    {
+        T * acc = &partials[i].value;
+        Run([&work, acc]() { work(*acc); }, &counter);
+    }
+
+    {
+        CScope scope;
+        work(partials[0].value);
+    }
+    Wait(&counter);
+
+    T result = std::move(partials[0].value);
+    for (uint i = 1; i < jobs; ++i)
+        result = combine(result, partials[i].value);
+    return result;
+}
+
+} // namespace Job
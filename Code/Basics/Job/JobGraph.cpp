@@ -0,0 +1,218 @@
+#include "JobPch.h"
+
+namespace Job
+{
+
+//*****************************************************************************
+//
+// Node
+//
+//*****************************************************************************
+
+struct CTaskGraph::Node
+{
+    const char *      name;
+    FJob              fn;
+    uint64            reads;
+    uint64            writes;
+    TArray<uint>      predecessors;
+    TArray<uint>      successors;
+    std::atomic<uint> pending;      // Predecessors yet to finish this Run
+    Time::Point       start;
+    Time::Point       finish;
+};
+
+
+
+//*****************************************************************************
+//
+// CTaskGraph
+//
+//*****************************************************************************
+
+//=============================================================================
+CTaskGraph::CTaskGraph ()
+{
+}
+
+//=============================================================================
+CTaskGraph::~CTaskGraph ()
+{
+    Clear();
+}
+
+//=============================================================================
+uint CTaskGraph::Add (const char name[], FJob fn, uint64 reads, uint64 writes)
+{
+    ASSERT(m_counter.IsDone());
+
+    const uint index = m_nodes.Count();
+
+    Node * node   = new Node;
+    node->name    = name;
+    node->fn      = std::move(fn);
+    node->reads   = reads;
+    node->writes  = writes;
+    node->pending.store(0, std::memory_order_relaxed);
+    m_nodes.Add(node);
+
+    // Read after write, write after read and write after write all conflict
+    for (uint i = 0; i < index; ++i)
+    {
+        const Node * earlier = m_nodes[i];
+        if ((earlier->writes & (reads | writes)) || (earlier->reads & writes))
+            AddDependency(index, i);
+    }
+
+    return index;
+}
+
+//=============================================================================
+void CTaskGraph::AddDependency (uint node, uint before)
+{
+    ASSERT(m_counter.IsDone());
+    ASSERT(node < m_nodes.Count());
+    ASSERT(before < node);
+
+    Node * after = m_nodes[node];
+    if (after->predecessors.Contains(before))
+        return;
+
+    after->predecessors.Add(before);
+    m_nodes[before]->successors.Add(node);
+}
+
+//=============================================================================
+void CTaskGraph::Clear ()
+{
+    ASSERT(m_counter.IsDone());
+
+    for (Node * node : m_nodes)
+        delete node;
+    m_nodes.Clear();
+    m_criticalPath.Clear();
+
+    m_duration         = Time::Delta();
+    m_criticalDuration = Time::Delta();
+}
+
+//=============================================================================
+void CTaskGraph::Run ()
+{
+    ASSERT(m_counter.IsDone());
+
+    // Runs start frames, and a Time::Update node may have moved frame arenas
+    // on from a worker. Catch up here, where this thread holds no temporaries,
+    // or it would keep filling its arena while it helps in Wait.
+    MemFrameSync();
+
+    for (Node * node : m_nodes)
+        node->pending.store(node->predecessors.Count(), std::memory_order_relaxed);
+
+    const Time::Point start = Time::GetRealTime();
+
+    for (uint i = 0; i < m_nodes.Count(); ++i)
+    {
+        if (m_nodes[i]->predecessors.IsEmpty())
+            Launch(i);
+    }
+
+    Wait(&m_counter);
+
+    m_duration = Time::GetRealTime() - start;
+    FindCriticalPath();
+}
+
+//=============================================================================
+const char * CTaskGraph::NodeName (uint node) const
+{
+    ASSERT(node < m_nodes.Count());
+    return m_nodes[node]->name;
+}
+
+//=============================================================================
+Time::Delta CTaskGraph::NodeDuration (uint node) const
+{
+    ASSERT(node < m_nodes.Count());
+    return m_nodes[node]->finish - m_nodes[node]->start;
+}
+
+//=============================================================================
+void CTaskGraph::Launch (uint node)
+{
+    Job::Run([this, node] { Execute(node); }, &m_counter);
+}
+
+//=============================================================================
+void CTaskGraph::Execute (uint index)
+{
+    Node * node = m_nodes[index];
+
+    node->start = Time::GetRealTime();
+    {
+        // Nodes are whole stages, free to split their own work across the pool
+        CTopLevelScope topLevel;
+        PROFILE_SCOPE(node->name);
+        node->fn();
+    }
+    node->finish = Time::GetRealTime();
+
+    // Launching before this job releases the counter keeps Run from seeing
+    // it reach zero while successors are still to come
+    for (uint successor : node->successors)
+    {
+        if (m_nodes[successor]->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Launch(successor);
+    }
+}
+
+//=============================================================================
+void CTaskGraph::FindCriticalPath ()
+{
+    m_criticalPath.Clear();
+    m_criticalDuration = Time::Delta();
+
+    const uint count = m_nodes.Count();
+    if (!count)
+        return;
+
+    // Ids are already in topological order, every edge points forward, so one
+    // pass finds the longest chain ending at each node
+    TArray<Time::Delta> longest;
+    TArray<sint>        via;
+    longest.Resize(count);
+    via.Resize(count);
+
+    uint last = 0;
+    for (uint i = 0; i < count; ++i)
+    {
+        Time::Delta best;
+        via[i] = -1;
+        for (uint predecessor : m_nodes[i]->predecessors)
+        {
+            if (longest[predecessor] > best)
+            {
+                best   = longest[predecessor];
+                via[i] = sint(predecessor);
+            }
+        }
+
+        longest[i] = best + NodeDuration(i);
+        if (longest[i] > longest[last])
+            last = i;
+    }
+
+    m_criticalDuration = longest[last];
+    for (sint node = sint(last); node >= 0; node = via[node])
+        m_criticalPath.Add(uint(node));
+
+    // Walked back from the end, put it in running order
+    for (uint i = 0, j = m_criticalPath.Count() - 1; i < j; ++i, --j)
+    {
+        const uint swap   = m_criticalPath[i];
+        m_criticalPath[i] = m_criticalPath[j];
+        m_criticalPath[j] = swap;
+    }
+}
+
+} // namespace Job
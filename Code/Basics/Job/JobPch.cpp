@@ -0,0 +1 @@
+#include "Basics/Job/JobPch.h"
\ No newline at end of file
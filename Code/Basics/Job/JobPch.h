@@ -0,0 +1,12 @@
+#ifdef JOBPCH_H
+#   error "Cannot include header more than once."
+#endif
+#define JOBPCH_H
+
+#include <atomic>
+#include <cstdio>
+
+#include "Ferrite.h"
+#include "Basics/Job.h"
+#include "Basics/Profile.h"
+#include "Utilities/allocator.h"
@@ -0,0 +1,121 @@
+#ifndef BASICS_PROFILE_H
+#define BASICS_PROFILE_H
+
+#include "Basics/Time.h"
+
+#ifdef BUILD_DEBUG
+#   define PROFILING
+#endif
+
+class CPath;
+
+namespace Profile
+{
+
+//*****************************************************************************
+//
+// Scopes
+//
+// Times hot paths. Mark a block with a name that lives for the whole run,
+// normally a string literal:
+//
+//      void CContext::Detection ()
+//      {
+//          PROFILE_SCOPE("Physics::Detection");
+//          ...
+//      }
+//
+// and its begin and end times are recorded when the block exits. Each thread
+// writes to a ring buffer of its own without locking or waiting; once a ring
+// is full the oldest events are overwritten, so only the last few thousand
+// scopes per thread are kept.
+//
+// Only compiled in when PROFILING is defined. Otherwise scopes expand to
+// nothing and the functions below record and report nothing.
+//
+//*****************************************************************************
+
+struct Event
+{
+    const char * name;
+    Time::Point  begin;
+    Time::Point  end;
+    uint16       thread;    // Index of the recording thread, see ThreadName
+    uint16       depth;     // Scopes open around this one on the same thread
+};
+
+#ifdef PROFILING
+
+class CScope
+{
+public:
+    explicit CScope (const char name[]);
+    ~CScope ();
+
+private:
+    CLASS_NO_COPY(CScope);
+
+    const char * m_name;
+    Time::Point  m_begin;
+    uint         m_depth;
+};
+
+#   define PROFILE_SCOPE(name) Profile::CScope UNIQUE_SYMBOL(profileScope)(name)
+
+#else
+
+#   define PROFILE_SCOPE(name)
+
+#endif
+
+
+
+//*****************************************************************************
+//
+// Capture
+//
+// Frames are marked by Time::Update. Captures copy events out of every
+// thread's ring while the threads keep recording; events overwritten during
+// the copy are left out rather than returned torn.
+//
+//*****************************************************************************
+
+#ifdef PROFILING
+
+// Names the calling thread in captures and traces
+void SetThreadName (const char name[]);
+
+void MarkFrame ();
+bool LastFrame (Time::Point * begin, Time::Point * end);   // False until two frames are marked
+
+void Capture (TArray<Event> * events);     // Everything still held
+void Capture (Time::Point begin, Time::Point end, TArray<Event> * events);     // Events overlapping [begin, end)
+
+uint ThreadCount ();
+void ThreadName (uint thread, char name[], uint size);
+
+// Writes everything still held in the Chrome trace event format, for
+// chrome://tracing or ui.perfetto.dev. Categories are taken from the part of
+// each name before "::".
+bool WriteChromeTrace (const CPath & filepath);
+
+#else
+
+inline void SetThreadName (const char[]) {}
+
+inline void MarkFrame () {}
+inline bool LastFrame (Time::Point *, Time::Point *) { return false; }
+
+inline void Capture (TArray<Event> *) {}
+inline void Capture (Time::Point, Time::Point, TArray<Event> *) {}
+
+inline uint ThreadCount () { return 0; }
+inline void ThreadName (uint, char name[], uint size) { if (size) name[0] = 0; }
+
+inline bool WriteChromeTrace (const CPath &) { return false; }
+
+#endif
+
+} // namespace Profile
+
+#endif // BASICS_PROFILE_H
@@ -0,0 +1,342 @@
+#include "ProfilePch.h"
+
+#ifdef PROFILING
+
+namespace Profile
+{
+
+//*****************************************************************************
+//
+// Constants
+//
+//*****************************************************************************
+
+const uint RING_CAPACITY = 8192;    // Events per thread, power of two
+const uint FRAME_HISTORY = 8;       // Power of two
+const uint NAME_LENGTH   = 32;
+
+
+
+//*****************************************************************************
+//
+// Ring
+//
+// One per thread that has recorded. Only the owner writes. It claims a slot
+// before writing it and publishes it after, so a reader that copies slots
+// and then checks the claim count knows which ones may have been rewritten
+// under it. Slots are atomics only so that such a race is well defined;
+// relaxed loads and stores compile to plain moves.
+//
+//*****************************************************************************
+
+namespace
+{
+
+struct Slot
+{
+    std::atomic<const char *> name;
+    std::atomic<sint64>       begin;
+    std::atomic<sint64>       end;
+    std::atomic<uint>         depth;
+};
+
+struct Ring
+{
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64> claimed;     // Writes started
+    std::atomic<uint64>                          published;   // Writes finished
+    uint                                         index;
+    char                                         name[NAME_LENGTH];    // Under s_lock
+    alignas(CACHE_LINE_SIZE) Slot                slots[RING_CAPACITY];
+};
+
+} // namespace
+
+
+
+//*****************************************************************************
+//
+// Internal State
+//
+//*****************************************************************************
+
+static CMutex               s_lock;
+static TArray<Ring *>       s_rings;    // Never freed, so events outlive their threads
+
+static std::atomic<sint64>  s_frameMarks[FRAME_HISTORY];
+static std::atomic<uint64>  s_frameCount;
+
+static thread_local Ring *  s_ring  = null;
+static thread_local uint    s_depth = 0;
+
+
+
+//*****************************************************************************
+//
+// Helpers
+//
+//*****************************************************************************
+
+//=============================================================================
+static Ring * GetRing ()
+{
+    if (s_ring)
+        return s_ring;
+
+    Ring * ring = new Ring;
+    ring->claimed.store(0, std::memory_order_relaxed);
+    ring->published.store(0, std::memory_order_relaxed);
+
+    TLockGuard<CMutex> guard(s_lock);
+    ring->index = s_rings.Count();
+    snprintf(ring->name, array_size(ring->name), "Thread %u", ring->index);
+    s_rings.Add(ring);
+
+    s_ring = ring;
+    return ring;
+}
+
+//=============================================================================
+static void Record (const char name[], Time::Point begin, Time::Point end, uint depth)
+{
+    Ring * ring = GetRing();
+
+    const uint64 index = ring->claimed.load(std::memory_order_relaxed);
+    ring->claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot & slot = ring->slots[index & (RING_CAPACITY - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin.GetRaw(), std::memory_order_relaxed);
+    slot.end.store(end.GetRaw(), std::memory_order_relaxed);
+    slot.depth.store(depth, std::memory_order_relaxed);
+
+    ring->published.store(index + 1, std::memory_order_release);
+}
+
+//=============================================================================
+static void CaptureRing (const Ring * ring, sint64 begin, sint64 end, TArray<Event> * events, TArray<uint64> * indices)
+{
+    // Newest first. Events are recorded as their scopes close, so end times
+    // only grow along the ring and the walk stops at the first one that
+    // finished before begin.
+    const uint64 published = ring->published.load(std::memory_order_acquire);
+    const uint64 oldest    = published > RING_CAPACITY ? published - RING_CAPACITY : 0;
+
+    const uint first = events->Count();
+    indices->Clear();
+
+    for (uint64 index = published; index > oldest; )
+    {
+        --index;
+        const Slot & slot = ring->slots[index & (RING_CAPACITY - 1)];
+
+        Event event;
+        event.end = Time::Point::FromNs(slot.end.load(std::memory_order_relaxed));
+        if (event.end.GetRaw() < begin)
+            break;
+
+        event.begin = Time::Point::FromNs(slot.begin.load(std::memory_order_relaxed));
+        if (event.begin.GetRaw() >= end)
+            continue;
+
+        event.name   = slot.name.load(std::memory_order_relaxed);
+        event.depth  = uint16(slot.depth.load(std::memory_order_relaxed));
+        event.thread = uint16(ring->index);
+        events->Add(event);
+        indices->Add(index);
+    }
+
+    // Drop whatever the owner may have started rewriting while it was copied.
+    // Those are the oldest, so always a tail of what was just added.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64 claimed = ring->claimed.load(std::memory_order_relaxed);
+    const uint64 safe    = claimed > RING_CAPACITY ? claimed - RING_CAPACITY : 0;
+
+    uint keep = indices->Count();
+    while (keep && (*indices)[keep - 1] < safe)
+        --keep;
+    events->Resize(first + keep);
+}
+
+//=============================================================================
+static void WriteJsonString (FILE * file, const char text[], uint length)
+{
+    fputc('"', file);
+    for (uint i = 0; i < length; ++i)
+    {
+        const char ch = text[i];
+        if (ch == '"' || ch == '\\')
+            fputc('\\', file);
+
+        if (uint8(ch) < 0x20)
+            fprintf(file, "\\u%04x", uint(uint8(ch)));
+        else
+            fputc(ch, file);
+    }
+    fputc('"', file);
+}
+
+
+
+//*****************************************************************************
+//
+// CScope
+//
+//*****************************************************************************
+
+//=============================================================================
+CScope::CScope (const char name[]) :
+    m_name(name),
+    m_depth(s_depth++)
+{
+    m_begin = Time::GetRealTime();
+}
+
+//=============================================================================
+CScope::~CScope ()
+{
+    const Time::Point end = Time::GetRealTime();
+    --s_depth;
+    Record(m_name, m_begin, end, m_depth);
+}
+
+
+
+//*****************************************************************************
+//
+// Capture
+//
+//*****************************************************************************
+
+//=============================================================================
+void SetThreadName (const char name[])
+{
+    Ring * ring = GetRing();
+
+    TLockGuard<CMutex> guard(s_lock);
+    strncpy(ring->name, name, array_size(ring->name) - 1);
+    ring->name[array_size(ring->name) - 1] = 0;
+}
+
+//=============================================================================
+void MarkFrame ()
+{
+    const uint64 count = s_frameCount.load(std::memory_order_relaxed);
+    s_frameMarks[count & (FRAME_HISTORY - 1)].store(Time::GetRealTime().GetRaw(), std::memory_order_relaxed);
+    s_frameCount.store(count + 1, std::memory_order_release);
+}
+
+//=============================================================================
+bool LastFrame (Time::Point * begin, Time::Point * end)
+{
+    ASSERT(begin && end);
+
+    const uint64 count = s_frameCount.load(std::memory_order_acquire);
+    if (count < 2)
+        return false;
+
+    *begin = Time::Point::FromNs(s_frameMarks[(count - 2) & (FRAME_HISTORY - 1)].load(std::memory_order_relaxed));
+    *end   = Time::Point::FromNs(s_frameMarks[(count - 1) & (FRAME_HISTORY - 1)].load(std::memory_order_relaxed));
+    return true;
+}
+
+//=============================================================================
+void Capture (TArray<Event> * events)
+{
+    Capture(Time::Point::FromNs(LLONG_MIN), Time::Point::FromNs(LLONG_MAX), events);
+}
+
+//=============================================================================
+void Capture (Time::Point begin, Time::Point end, TArray<Event> * events)
+{
+    ASSERT(events);
+    events->Clear();
+
+    TArray<uint64> indices;
+
+    TLockGuard<CMutex> guard(s_lock);
+    for (const Ring * ring : s_rings)
+        CaptureRing(ring, begin.GetRaw(), end.GetRaw(), events, &indices);
+}
+
+//=============================================================================
+uint ThreadCount ()
+{
+    TLockGuard<CMutex> guard(s_lock);
+    return s_rings.Count();
+}
+
+//=============================================================================
+void ThreadName (uint thread, char name[], uint size)
+{
+    ASSERT(size);
+
+    TLockGuard<CMutex> guard(s_lock);
+    if (thread >= s_rings.Count())
+    {
+        name[0] = 0;
+        return;
+    }
+
+    strncpy(name, s_rings[thread]->name, size - 1);
+    name[size - 1] = 0;
+}
+
+//=============================================================================
+bool WriteChromeTrace (const CPath & filepath)
+{
+    TArray<Event> events;
+    Capture(&events);
+
+    FILE * file = fopen((const char *)filepath.GetString().Ptr(), "w");
+    if (!file)
+        return false;
+
+    // Timestamps are microseconds; counting from the first event keeps
+    // nanoseconds within a double's precision
+    sint64 origin = LLONG_MAX;
+    for (const Event & event : events)
+        origin = Min(origin, event.begin.GetRaw());
+
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+
+    bool first = true;
+    for (uint thread = 0, count = ThreadCount(); thread < count; ++thread)
+    {
+        char name[NAME_LENGTH];
+        ThreadName(thread, name, array_size(name));
+
+        fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",", thread);
+        WriteJsonString(file, name, uint(strlen(name)));
+        fputs("}}", file);
+        first = false;
+    }
+
+    for (const Event & event : events)
+    {
+        const char * separator = strstr(event.name, "::");
+        const uint   length    = uint(strlen(event.name));
+
+        fprintf(file, "%s\n{\"name\":", first ? "" : ",");
+        WriteJsonString(file, event.name, length);
+        fputs(",\"cat\":", file);
+        WriteJsonString(file, event.name, separator ? uint(separator - event.name) : length);
+        fprintf(
+            file,
+            ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+            float64(event.begin.GetRaw() - origin) / float64(Time::NS_PER_US),
+            float64((event.end - event.begin).GetRaw()) / float64(Time::NS_PER_US),
+            uint(event.thread)
+        );
+        first = false;
+    }
+
+    fputs("\n]}\n", file);
+    const bool success = !ferror(file);
+    fclose(file);
+    return success;
+}
+
+} // namespace Profile
+
+#endif // PROFILING
@@ -0,0 +1 @@
+#include "Basics/Profile/ProfilePch.h"
\ No newline at end of file
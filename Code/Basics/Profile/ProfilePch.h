@@ -0,0 +1,14 @@
+#ifdef PROFILEPCH_H
+#   error "Cannot include header more than once."
+#endif
+#define PROFILEPCH_H
+
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+#include "Ferrite.h"
+#include "Basics/Path.h"
+#include "Basics/Profile.h"
+#include "Basics/Thread.h"
@@ -0,0 +1,206 @@
+#ifndef BASICS_TASK_H
+#define BASICS_TASK_H
+
+#include "Basics/Job.h"
+#include "Basics/Path.h"
+
+// Coroutines need compiler support; without it none of this is declared
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <optional>
+
+namespace Job
+{
+
+namespace Internal
+{
+
+//*****************************************************************************
+//
+// Forwards
+//
+//*****************************************************************************
+
+template <typename T>
+class TPromise;
+
+typedef std::function<bool ()> FCondition;
+
+void QueueFrame (std::coroutine_handle<> handle, FCondition condition);
+
+} // namespace Internal
+
+
+
+//*****************************************************************************
+//
+// TTask
+//
+// Result of a coroutine that co_returns a T. Tasks are lazy: the body starts
+// when the task is first awaited, on the awaiting thread, and the awaiting
+// coroutine resumes on whichever thread the task finishes on. Long operations
+// can then be written as straight-line code that suspends on the awaitables
+// below instead of as a hand-rolled state machine:
+//
+//      Job::TTask<void> LoadLevel (CPath path)
+//      {
+//          TArray<byte> data = co_await Job::ReadFile(path);
+//          CLevel * level = co_await Job::Async([&] { return ParseLevel(data); });
+//          co_await Job::NextFrame();
+//          AddToWorld(level);
+//      }
+//
+//      Job::Spawn(LoadLevel(path));
+//
+// Anything a task refers to by reference must outlive it; pass values in as
+// parameters, which the coroutine copies.
+//
+//*****************************************************************************
+
+template <typename T = void>
+class TTask
+{
+public:
+    typedef Internal::TPromise<T> promise_type;
+
+    TTask ();
+    TTask (TTask<T> && rhs);
+    ~TTask ();
+
+    TTask<T> & operator= (TTask<T> && rhs);
+
+    bool IsValid () const;
+    bool IsDone () const;
+
+    // Awaiting a task starts it and suspends until it finishes
+    bool                    await_ready () const noexcept;
+    std::coroutine_handle<> await_suspend (std::coroutine_handle<> awaiting) noexcept;
+    T                       await_resume ();
+
+private:
+    CLASS_NO_COPY(TTask);
+
+    friend promise_type;
+    explicit TTask (std::coroutine_handle<promise_type> handle);
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+
+
+//*****************************************************************************
+//
+// Scheduling
+//
+//*****************************************************************************
+
+// Runs a task to completion on the job system without an awaiting coroutine.
+// counter, if given, works as for Run.
+void Spawn (TTask<void> task, CCounter * counter = null);
+
+// Resumes every task waiting on NextFrame, and those waiting on Until whose
+// condition now holds, as jobs. Call once per frame from the frame loop.
+void UpdateTasks ();
+
+
+
+//*****************************************************************************
+//
+// Awaitables
+//
+//*****************************************************************************
+
+// Resumes as a job on the next call to UpdateTasks
+class CNextFrame
+{
+public:
+    bool await_ready () const noexcept { return false; }
+    void await_suspend (std::coroutine_handle<> handle) const;
+    void await_resume () const noexcept {}
+};
+
+CNextFrame NextFrame ();
+
+
+// Resumes straight away if condition holds, otherwise on the first call to
+// UpdateTasks where it does. The condition is polled on the UpdateTasks thread.
+class CUntil
+{
+public:
+    explicit CUntil (Internal::FCondition condition) : m_condition(std::move(condition)) {}
+
+    bool await_ready () const { return m_condition(); }
+    void await_suspend (std::coroutine_handle<> handle);
+    void await_resume () const noexcept {}
+
+private:
+    Internal::FCondition m_condition;
+};
+
+CUntil Until (Internal::FCondition condition);
+
+
+// Resumes as a job once every job counted by counter has finished, without
+// holding a thread while it waits. Only one task may await a counter at a time.
+class CCompletion
+{
+public:
+    explicit CCompletion (CCounter * counter) : m_counter(counter) {}
+
+    bool await_ready () const { return !m_counter || m_counter->IsDone(); }
+    void await_suspend (std::coroutine_handle<> handle) const;
+    void await_resume () const noexcept {}
+
+private:
+    CCounter * m_counter;
+};
+
+CCompletion Completion (CCounter * counter);
+
+
+// Runs fn as a job and resumes on that job with fn's result
+template <typename F, typename R = decltype(std::declval<F &>()())>
+class TAsync
+{
+public:
+    explicit TAsync (F fn) : m_fn(std::move(fn)) {}
+
+    bool await_ready () const noexcept { return false; }
+    void await_suspend (std::coroutine_handle<> handle);
+    R    await_resume () { return std::move(*m_result); }
+
+private:
+    F                m_fn;
+    std::optional<R> m_result;
+};
+
+template <typename F>
+class TAsync<F, void>
+{
+public:
+    explicit TAsync (F fn) : m_fn(std::move(fn)) {}
+
+    bool await_ready () const noexcept { return false; }
+    void await_suspend (std::coroutine_handle<> handle);
+    void await_resume () const noexcept {}
+
+private:
+    F m_fn;
+};
+
+template <typename F>
+TAsync<F> Async (F fn);
+
+
+// Reads a whole binary file on the job system, keeping blocking file I/O off
+// the awaiting thread
+TTask<TArray<byte>> ReadFile (CPath path);
+
+} // namespace Job
+
+#include "Task/Task.inl"
+
+#endif // __cpp_impl_coroutine
+
+#endif // BASICS_TASK_H
@@ -0,0 +1,209 @@
+#include "TaskPch.h"
+
+#if defined(__cpp_impl_coroutine)
+
+namespace Job
+{
+
+//*****************************************************************************
+//
+// CDetached
+//
+// Owner of a spawned task. Starts eagerly, frees itself when it finishes.
+//
+//*****************************************************************************
+
+namespace
+{
+
+class CDetached
+{
+public:
+    class promise_type
+    {
+    public:
+        CDetached           get_return_object () const noexcept { return CDetached(); }
+        std::suspend_never  initial_suspend () const noexcept { return std::suspend_never(); }
+        std::suspend_never  final_suspend () const noexcept { return std::suspend_never(); }
+
+        void return_void () const noexcept {}
+        void unhandled_exception () { FATAL_EXIT("Unhandled exception in task"); }
+    };
+};
+
+class CResumeOnJob
+{
+public:
+    bool await_ready () const noexcept { return false; }
+    void await_suspend (std::coroutine_handle<> handle) const { Run([handle] { handle.resume(); }); }
+    void await_resume () const noexcept {}
+};
+
+struct FrameWaiter
+{
+    std::coroutine_handle<> handle;
+    Internal::FCondition    condition;     // Empty to resume on the next frame unconditionally
+};
+
+} // namespace
+
+
+
+//*****************************************************************************
+//
+// Internal State
+//
+//*****************************************************************************
+
+static CMutex               s_frameLock;
+static TArray<FrameWaiter>  s_frameWaiters;
+static TArray<FrameWaiter>  s_frameWaitersUpdating;  // Kept to reuse its storage
+
+
+
+//*****************************************************************************
+//
+// Helpers
+//
+//*****************************************************************************
+
+//=============================================================================
+static CDetached RunDetached (TTask<void> task, CCounter * counter)
+{
+    // Move off the spawning thread before doing any of the work
+    co_await CResumeOnJob();
+    co_await task;
+
+    if (counter)
+        counter->Release();
+}
+
+
+
+//*****************************************************************************
+//
+// Internal
+//
+//*****************************************************************************
+
+//=============================================================================
+void Internal::QueueFrame (std::coroutine_handle<> handle, FCondition condition)
+{
+    FrameWaiter waiter;
+    waiter.handle    = handle;
+    waiter.condition = std::move(condition);
+
+    TLockGuard<CMutex> guard(s_frameLock);
+    s_frameWaiters.Add(std::move(waiter));
+}
+
+
+
+//*****************************************************************************
+//
+// Scheduling
+//
+//*****************************************************************************
+
+//=============================================================================
+void Spawn (TTask<void> task, CCounter * counter)
+{
+    ASSERT(task.IsValid());
+
+    if (counter)
+        counter->Add();
+
+    RunDetached(std::move(task), counter);
+}
+
+//=============================================================================
+void UpdateTasks ()
+{
+    // Take this frame's waiters; any that suspend again while resuming land
+    // in the fresh list and wait for the next call
+    TArray<FrameWaiter> & waiters = s_frameWaitersUpdating;
+    ASSERT(waiters.IsEmpty());
+    {
+        TLockGuard<CMutex> guard(s_frameLock);
+        std::swap(waiters, s_frameWaiters);
+    }
+
+    for (FrameWaiter & waiter : waiters)
+    {
+        if (waiter.condition && !waiter.condition())
+        {
+            Internal::QueueFrame(waiter.handle, std::move(waiter.condition));
+            continue;
+        }
+
+        const std::coroutine_handle<> handle = waiter.handle;
+        Run([handle] { handle.resume(); });
+    }
+
+    waiters.Clear();
+}
+
+
+
+//*****************************************************************************
+//
+// Awaitables
+//
+//*****************************************************************************
+
+//=============================================================================
+void CNextFrame::await_suspend (std::coroutine_handle<> handle) const
+{
+    Internal::QueueFrame(handle, Internal::FCondition());
+}
+
+//=============================================================================
+CNextFrame NextFrame ()
+{
+    return CNextFrame();
+}
+
+//=============================================================================
+void CUntil::await_suspend (std::coroutine_handle<> handle)
+{
+    Internal::QueueFrame(handle, std::move(m_condition));
+}
+
+//=============================================================================
+CUntil Until (Internal::FCondition condition)
+{
+    return CUntil(std::move(condition));
+}
+
+//=============================================================================
+void CCompletion::await_suspend (std::coroutine_handle<> handle) const
+{
+    // Resumed as a job of its own once the last counted job releases the
+    // counter, so no thread waits in the meantime
+    m_counter->OnDone(
+        [](void * address) {
+            const std::coroutine_handle<> handle = std::coroutine_handle<>::from_address(address);
+            Run([handle] { handle.resume(); });
+        },
+        handle.address()
+    );
+}
+
+//=============================================================================
+CCompletion Completion (CCounter * counter)
+{
+    return CCompletion(counter);
+}
+
+//=============================================================================
+TTask<TArray<byte>> ReadFile (CPath path)
+{
+    co_return co_await Async([&path] {
+        File::CBinaryReader reader(path);
+        return reader.ReadAll();
+    });
+}
+
+} // namespace Job
+
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,214 @@
+namespace Job
+{
+
+namespace Internal
+{
+
+//*****************************************************************************
+//
+// CFinalAwaiter
+//
+// Hands the thread straight to the coroutine awaiting a finished task, if
+// any, rather than returning up the stack and resuming it from there.
+//
+//*****************************************************************************
+
+class CFinalAwaiter
+{
+public:
+    bool await_ready () const noexcept { return false; }
+
+    template <typename P>
+    std::coroutine_handle<> await_suspend (std::coroutine_handle<P> handle) const noexcept
+    {
+        std::coroutine_handle<> continuation = handle.promise().m_continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume () const noexcept {}
+};
+
+
+
+//*****************************************************************************
+//
+// CPromiseBase
+//
+//*****************************************************************************
+
+class CPromiseBase
+{
+public:
+    std::suspend_always initial_suspend () const noexcept { return std::suspend_always(); }
+    CFinalAwaiter       final_suspend () const noexcept { return CFinalAwaiter(); }
+
+    void unhandled_exception () { FATAL_EXIT("Unhandled exception in task"); }
+
+    std::coroutine_handle<> m_continuation;
+};
+
+
+
+//*****************************************************************************
+//
+// TPromise
+//
+//*****************************************************************************
+
+template <typename T>
+class TPromise : public CPromiseBase
+{
+public:
+    TTask<T> get_return_object ()
+    {
+        return TTask<T>(std::coroutine_handle<TPromise<T>>::from_promise(*this));
+    }
+
+    template <typename U>
+    void return_value (U && value) { m_value.emplace(std::forward<U>(value)); }
+
+    std::optional<T> m_value;
+};
+
+template <>
+class TPromise<void> : public CPromiseBase
+{
+public:
+    TTask<void> get_return_object ()
+    {
+        return TTask<void>(std::coroutine_handle<TPromise<void>>::from_promise(*this));
+    }
+
+    void return_void () {}
+};
+
+} // namespace Internal
+
+
+
+//*****************************************************************************
+//
+// TTask
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T>
+TTask<T>::TTask () :
+    m_handle(null)
+{
+}
+
+//=============================================================================
+template <typename T>
+TTask<T>::TTask (std::coroutine_handle<promise_type> handle) :
+    m_handle(handle)
+{
+}
+
+//=============================================================================
+template <typename T>
+TTask<T>::TTask (TTask<T> && rhs) :
+    m_handle(rhs.m_handle)
+{
+    rhs.m_handle = null;
+}
+
+//=============================================================================
+template <typename T>
+TTask<T>::~TTask ()
+{
+    if (m_handle)
+        m_handle.destroy();
+}
+
+//=============================================================================
+template <typename T>
+TTask<T> & TTask<T>::operator= (TTask<T> && rhs)
+{
+    if (this != &rhs)
+    {
+        if (m_handle)
+            m_handle.destroy();
+        m_handle     = rhs.m_handle;
+        rhs.m_handle = null;
+    }
+    return *this;
+}
+
+//=============================================================================
+template <typename T>
+bool TTask<T>::IsValid () const
+{
+    return bool(m_handle);
+}
+
+//=============================================================================
+template <typename T>
+bool TTask<T>::IsDone () const
+{
+    return m_handle && m_handle.done();
+}
+
+//=============================================================================
+template <typename T>
+bool TTask<T>::await_ready () const noexcept
+{
+    return !m_handle || m_handle.done();
+}
+
+//=============================================================================
+template <typename T>
+std::coroutine_handle<> TTask<T>::await_suspend (std::coroutine_handle<> awaiting) noexcept
+{
+    m_handle.promise().m_continuation = awaiting;
+    return m_handle;
+}
+
+//=============================================================================
+template <typename T>
+T TTask<T>::await_resume ()
+{
+    if constexpr (!std::is_void<T>::value)
+    {
+        ASSERT(m_handle && m_handle.promise().m_value);
+        return std::move(*m_handle.promise().m_value);
+    }
+}
+
+
+
+//*****************************************************************************
+//
+// TAsync
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename F, typename R>
+void TAsync<F, R>::await_suspend (std::coroutine_handle<> handle)
+{
+    Run([this, handle] {
+        m_result.emplace(m_fn());
+        handle.resume();
+    });
+}
+
+//=============================================================================
+template <typename F>
+void TAsync<F, void>::await_suspend (std::coroutine_handle<> handle)
+{
+    Run([this, handle] {
+        m_fn();
+        handle.resume();
+    });
+}
+
+//=============================================================================
+template <typename F>
+TAsync<F> Async (F fn)
+{
+    return TAsync<F>(std::move(fn));
+}
+
+} // namespace Job
@@ -0,0 +1 @@
+#include "Basics/Task/TaskPch.h"
\ No newline at end of file
@@ -0,0 +1,9 @@
+#ifdef TASKPCH_H
+#   error "Cannot include header more than once."
+#endif
+#define TASKPCH_H
+
+#include "Ferrite.h"
+#include "Basics/File.h"
+#include "Basics/Task.h"
+#include "Basics/Thread.h"
@@ -1,6 +1,8 @@
 #ifndef BASICS_THREAD_H
 #define BASICS_THREAD_H
 
+#include <atomic>
+
 #include "Basics/Time.h"
 
 
@@ -12,6 +14,17 @@
 
 typedef uint32 ThreadId;
 
+// Logical processors, numbered as the OS does. Windows processor groups are
+// numbered consecutively.
+const uint THREAD_MAX_CPUS = 256;
+typedef TBitSet<THREAD_MAX_CPUS> CpuSet;
+
+struct CpuCore
+{
+    CpuSet cpus;    // Logical processors sharing the core, SMT siblings
+    uint   node;    // NUMA node
+};
+
 
 
 //*****************************************************************************
@@ -22,6 +35,9 @@ typedef uint32 ThreadId;
 
 class Thread;
 class CriticalSection;
+class CMutex;
+class CRwLock;
+class CTicketLock;
 
 
 
@@ -39,16 +55,29 @@ public:
     
     void Start ();
     void Stop ();
+    void Join ();
     void Suspend ();
     void Resume ();
     bool IsRunning () const;
 
+    // May be called before Start, in which case they take effect before the
+    // thread runs any code. Names show up in debuggers and profilers; Linux
+    // truncates them to 15 characters.
+    void SetName (const char name[]);
+    bool SetAffinity (const CpuSet & cpus);
+    bool SetNumaNode (uint node);   // Affinity to every processor on node
+
     virtual void ThreadEnter () pure;
 
 private:
 
+    bool ApplyName ();
+    bool ApplyAffinity ();
+
     ThreadId m_id;
     void *   m_handle;
+    char     m_name[32];
+    CpuSet   m_affinity;    // Empty to run anywhere
 };
 
 
@@ -69,10 +98,11 @@ public:
     void Enter ();
     void Leave ();
     
-    static const uint DATA_SIZE = 48;
+    static const uint DATA_SIZE  = 48;
+    static const uint DATA_ALIGN = 8;
 
 private:
-    uint8 m_data[DATA_SIZE];
+    alignas(DATA_ALIGN) uint8 m_data[DATA_SIZE];
 };
 
 
@@ -129,6 +159,346 @@ public:
 
 
 
+//*****************************************************************************
+//
+// Address waits
+//
+// Sleep while *addr holds expected; may also wake spuriously, so callers loop
+// on their own condition. Futexes on Linux, WaitOnAddress on Windows.
+//
+//*****************************************************************************
+
+void ThreadWaitOnAddress (std::atomic<uint32> * addr, uint32 expected);
+void ThreadWakeByAddress (std::atomic<uint32> * addr, bool all);
+
+
+
+//*****************************************************************************
+//
+// Lock statistics
+//
+// With LOCK_STATS defined every lock below counts how often it was taken, how
+// often the taker found it already held, and how often a waiter gave up
+// spinning and slept. Without it the counters compile away, GetStats reports
+// zeroes and CMutex is four bytes.
+//
+//*****************************************************************************
+
+#ifdef BUILD_DEBUG
+#   define LOCK_STATS
+#endif
+
+#ifdef LOCK_STATS
+#   define LOCK_STAT(x) x
+#else
+#   define LOCK_STAT(x)
+#endif
+
+struct LockStats
+{
+    uint64 acquires;
+    uint64 contended;   // Acquires that had to wait
+    uint64 sleeps;      // Times a waiter stopped spinning and slept or yielded
+};
+
+#ifdef LOCK_STATS
+
+class CLockCounters
+{
+public:
+    CLockCounters ();
+
+    void Acquired (bool contended);
+    void Slept () { m_sleeps.fetch_add(1, std::memory_order_relaxed); }
+
+    LockStats Get () const;
+    void      Reset ();
+
+private:
+    std::atomic<uint64> m_acquires;
+    std::atomic<uint64> m_contended;
+    std::atomic<uint64> m_sleeps;
+};
+
+#endif // LOCK_STATS
+
+
+
+//*****************************************************************************
+//
+// CMutex
+//
+// Non-recursive mutex in a single word. Uncontended Lock and Unlock are one
+// atomic operation each. A thread that finds the lock held spins briefly,
+// skipped on single processor machines where the holder cannot be running,
+// then sleeps on the lock word until woken by Unlock.
+//
+//*****************************************************************************
+
+class CMutex
+{
+public:
+    CMutex () : m_state(UNLOCKED) {}
+
+    bool TryLock ();
+    void Lock ();
+    void Unlock ();
+
+    LockStats GetStats () const;
+    void      ResetStats ();
+
+private:
+    CLASS_NO_COPY(CMutex);
+
+    void LockContended ();
+
+    enum : uint32
+    {
+        UNLOCKED,
+        LOCKED,
+        CONTENDED,      // Locked, and a thread may be asleep waiting for it
+    };
+
+    std::atomic<uint32> m_state;
+    LOCK_STAT(CLockCounters m_stats;)
+};
+
+#ifndef LOCK_STATS
+static_assert(sizeof(CMutex) == 4, "CMutex should fit in one word");
+#endif
+
+//=============================================================================
+inline bool CMutex::TryLock ()
+{
+    uint32 expected = UNLOCKED;
+    if (!m_state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+        return false;
+
+    LOCK_STAT(m_stats.Acquired(false));
+    return true;
+}
+
+//=============================================================================
+inline void CMutex::Lock ()
+{
+    if (!TryLock())
+        LockContended();
+}
+
+//=============================================================================
+inline void CMutex::Unlock ()
+{
+    if (m_state.exchange(UNLOCKED, std::memory_order_release) == CONTENDED)
+        ThreadWakeByAddress(&m_state, false);
+}
+
+
+
+//*****************************************************************************
+//
+// CRwLock
+//
+// Reader-writer lock for read-mostly data. Any number of readers share the
+// lock, writers take it alone. A waiting writer holds off new readers so a
+// steady stream of them cannot starve it; the flip side is that taking a read
+// lock the thread already holds can deadlock against a waiting writer, so the
+// lock is not recursive in either mode.
+//
+//*****************************************************************************
+
+class CRwLock
+{
+public:
+    CRwLock () : m_state(0), m_writersWaiting(0), m_sleepers(0) {}
+
+    bool TryLockShared ();
+    void LockShared ();
+    void UnlockShared ();
+
+    bool TryLock ();
+    void Lock ();
+    void Unlock ();
+
+    LockStats GetStats () const;
+    void      ResetStats ();
+
+private:
+    CLASS_NO_COPY(CRwLock);
+
+    void LockSharedContended ();
+    void LockContended ();
+    void Sleep (uint32 state);
+    void WakeAll ();
+
+    static const uint32 WRITER = 0x80000000;    // Low bits count readers
+
+    std::atomic<uint32> m_state;
+    std::atomic<uint32> m_writersWaiting;
+    std::atomic<uint32> m_sleepers;
+    LOCK_STAT(CLockCounters m_stats;)
+};
+
+//=============================================================================
+inline bool CRwLock::TryLockShared ()
+{
+    uint32 state = m_state.load(std::memory_order_relaxed);
+    if ((state & WRITER) || m_writersWaiting.load(std::memory_order_relaxed))
+        return false;
+
+    if (!m_state.compare_exchange_strong(state, state + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    LOCK_STAT(m_stats.Acquired(false));
+    return true;
+}
+
+//=============================================================================
+inline void CRwLock::LockShared ()
+{
+    if (!TryLockShared())
+        LockSharedContended();
+}
+
+//=============================================================================
+inline void CRwLock::UnlockShared ()
+{
+    // Only the last reader out can let a writer in
+    if (m_state.fetch_sub(1, std::memory_order_seq_cst) == 1)
+        WakeAll();
+}
+
+//=============================================================================
+inline bool CRwLock::TryLock ()
+{
+    uint32 expected = 0;
+    if (!m_state.compare_exchange_strong(expected, WRITER, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    LOCK_STAT(m_stats.Acquired(false));
+    return true;
+}
+
+//=============================================================================
+inline void CRwLock::Lock ()
+{
+    if (!TryLock())
+        LockContended();
+}
+
+//=============================================================================
+inline void CRwLock::Unlock ()
+{
+    m_state.store(0, std::memory_order_seq_cst);
+    WakeAll();
+}
+
+
+
+//*****************************************************************************
+//
+// CTicketLock
+//
+// Fair spin lock: threads get the lock in the order they asked for it. Meant
+// for very short critical sections where FIFO order matters more than letting
+// the holder's core re-take the lock. Waiters never sleep, but do yield their
+// time slice once they have spun for a while.
+//
+//*****************************************************************************
+
+class CTicketLock
+{
+public:
+    CTicketLock () : m_next(0), m_serving(0) {}
+
+    bool TryLock ();
+    void Lock ();
+    void Unlock ();
+
+    LockStats GetStats () const;
+    void      ResetStats ();
+
+private:
+    CLASS_NO_COPY(CTicketLock);
+
+    void LockContended (uint32 ticket);
+
+    std::atomic<uint32> m_next;
+    std::atomic<uint32> m_serving;
+    LOCK_STAT(CLockCounters m_stats;)
+};
+
+//=============================================================================
+inline bool CTicketLock::TryLock ()
+{
+    uint32 serving = m_serving.load(std::memory_order_acquire);
+    if (!m_next.compare_exchange_strong(serving, serving + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        return false;
+
+    LOCK_STAT(m_stats.Acquired(false));
+    return true;
+}
+
+//=============================================================================
+inline void CTicketLock::Lock ()
+{
+    const uint32 ticket = m_next.fetch_add(1, std::memory_order_relaxed);
+    if (m_serving.load(std::memory_order_acquire) != ticket)
+    {
+        LockContended(ticket);
+        return;
+    }
+
+    LOCK_STAT(m_stats.Acquired(false));
+}
+
+//=============================================================================
+inline void CTicketLock::Unlock ()
+{
+    // Only the holder writes m_serving
+    m_serving.store(m_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+
+
+//*****************************************************************************
+//
+// Lock guards
+//
+// Scoped locking for anything with Lock and Unlock, including Lockable, or
+// LockShared and UnlockShared:
+//
+//      TLockGuard<CMutex> guard(m_lock);
+//
+//*****************************************************************************
+
+template <typename L>
+class TLockGuard
+{
+public:
+    explicit TLockGuard (L & lock) : m_lock(lock) { m_lock.Lock(); }
+    ~TLockGuard () { m_lock.Unlock(); }
+
+private:
+    CLASS_NO_COPY(TLockGuard);
+
+    L & m_lock;
+};
+
+template <typename L>
+class TSharedLockGuard
+{
+public:
+    explicit TSharedLockGuard (L & lock) : m_lock(lock) { m_lock.LockShared(); }
+    ~TSharedLockGuard () { m_lock.UnlockShared(); }
+
+private:
+    CLASS_NO_COPY(TSharedLockGuard);
+
+    L & m_lock;
+};
+
+
+
 //*****************************************************************************
 //
 // Functions
@@ -137,5 +507,12 @@ public:
 
 uint ThreadLogicalProcessorCount ();
 void ThreadSleep (Time::Delta duration);
+void ThreadYield ();
+
+// Physical cores the process may run on, ordered by NUMA node
+void   ThreadGetCores (TArray<CpuCore> * cores);
+uint   ThreadNumaNodeCount ();
+CpuSet ThreadNumaNodeCpus (uint node);
+uint   ThreadCurrentNumaNode ();
 
 #endif // BASICS_THREAD_H
\ No newline at end of file
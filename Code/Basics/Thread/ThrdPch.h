@@ -4,7 +4,33 @@
 #define THRDPCH_H
 
 #include <mutex>
-#include <Windows.h>
+
+#include "platform.h"
+
+#if FE_ARCH_X86 || FE_ARCH_X64
+#   include <emmintrin.h>
+#endif
+
+#if FE_THREAD_WIN32
+#   include <cstring>
+#   include <Windows.h>
+#else
+#   if !FE_OS_LINUX
+#       error "The POSIX thread backend waits on Linux futexes"
+#   endif
+#   include <atomic>
+#   include <cerrno>
+#   include <climits>
+#   include <cstdio>
+#   include <cstring>
+#   include <ctime>
+#   include <pthread.h>
+#   include <sched.h>
+#   include <signal.h>
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
 
 #include "Ferrite.h"
-#include "Basics/Thread.h"
\ No newline at end of file
+#include "Basics/Thread.h"
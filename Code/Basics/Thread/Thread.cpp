@@ -1,5 +1,9 @@
 #include "ThrdPch.h"
 
+#if FE_THREAD_WIN32
+
+// WaitOnAddress and WakeByAddress
+#pragma comment(lib, "Synchronization.lib")
 
 //*****************************************************************************
 //
@@ -9,6 +13,7 @@
 
 //=============================================================================
 static_assert(CriticalSection::DATA_SIZE >= uint(sizeof(CRITICAL_SECTION)), "Not enough space to old critical section data");
+static_assert(CriticalSection::DATA_ALIGN >= uint(alignof(CRITICAL_SECTION)), "Critical section data is not aligned enough");
 
 
 
@@ -24,6 +29,57 @@ inline CRITICAL_SECTION * ConvertCritSec (uint8 * data)
     return (CRITICAL_SECTION *)data;
 }
 
+//=============================================================================
+static uint GroupFirstCpu (WORD group)
+{
+    // Groups are numbered consecutively, so a group's processors follow on
+    // from every group before it
+    uint first = 0;
+    for (WORD i = 0; i < group; ++i)
+        first += ::GetActiveProcessorCount(i);
+    return first;
+}
+
+//=============================================================================
+static void AddGroupMask (const GROUP_AFFINITY & affinity, CpuSet * cpus)
+{
+    const uint first = GroupFirstCpu(affinity.Group);
+    for (uint bit = 0; bit < 64; ++bit)
+    {
+        if ((uint64(affinity.Mask) >> bit) & 1 && first + bit < THREAD_MAX_CPUS)
+            cpus->Set(first + bit);
+    }
+}
+
+//=============================================================================
+static bool ToGroupAffinity (const CpuSet & cpus, GROUP_AFFINITY * out)
+{
+    // A thread can only be bound to processors in one group, pick the group
+    // of the lowest processor asked for
+    memset(out, 0, sizeof(*out));
+    const uint lowest = cpus.FindFirstSet();
+
+    uint first = 0;
+    const WORD groupCount = ::GetActiveProcessorGroupCount();
+    for (WORD group = 0; group < groupCount; ++group)
+    {
+        const uint count = ::GetActiveProcessorCount(group);
+        if (lowest < first + count)
+        {
+            out->Group = group;
+            for (uint cpu = first; cpu < first + count && cpu < THREAD_MAX_CPUS; ++cpu)
+            {
+                if (cpus.Get(cpu))
+                    out->Mask |= KAFFINITY(1) << (cpu - first);
+            }
+            return true;
+        }
+        first += count;
+    }
+
+    return false;
+}
+
 //=============================================================================
 static DWORD WINAPI ThreadEntryPoint (LPVOID param)
 {
@@ -48,6 +104,7 @@ CThread::CThread () :
     m_id(0),
     m_handle(NULL)
 {
+    m_name[0] = 0;
 }
 
 //=============================================================================
@@ -59,7 +116,18 @@ CThread::~CThread ()
 //=============================================================================
 void CThread::Start()
 {
-    m_handle = ::CreateThread(null, 0, ThreadEntryPoint, this, 0, (LPDWORD)&m_id);
+    // Created suspended so the name and affinity are in place before any of
+    // the thread's code runs
+    m_handle = ::CreateThread(null, 0, ThreadEntryPoint, this, CREATE_SUSPENDED, (LPDWORD)&m_id);
+    if (!m_handle)
+        return;
+
+    if (m_name[0])
+        ApplyName();
+    if (m_affinity.Any())
+        ApplyAffinity();
+
+    ::ResumeThread(m_handle);
 }
 
 //=============================================================================
@@ -68,6 +136,12 @@ void CThread::Stop()
     ::TerminateThread(m_handle, 0);
 }
 
+//=============================================================================
+void CThread::Join()
+{
+    ::WaitForSingleObject(m_handle, INFINITE);
+}
+
 //=============================================================================
 void CThread::Suspend()
 {
@@ -89,6 +163,66 @@ bool CThread::IsRunning() const
     return exitCode == STILL_ACTIVE;
 }
 
+//=============================================================================
+void CThread::SetName (const char name[])
+{
+    strncpy(m_name, name, array_size(m_name) - 1);
+    m_name[array_size(m_name) - 1] = 0;
+
+    if (m_handle)
+        ApplyName();
+}
+
+//=============================================================================
+bool CThread::SetAffinity (const CpuSet & cpus)
+{
+    m_affinity = cpus;
+    return m_handle ? ApplyAffinity() : true;
+}
+
+//=============================================================================
+bool CThread::SetNumaNode (uint node)
+{
+    const CpuSet cpus = ThreadNumaNodeCpus(node);
+    if (cpus.None())
+        return false;
+
+    return SetAffinity(cpus);
+}
+
+//=============================================================================
+bool CThread::ApplyName ()
+{
+    wchar_t name[array_size(m_name)];
+    if (!::MultiByteToWideChar(CP_UTF8, 0, m_name, -1, name, array_size(name)))
+        return false;
+
+    return SUCCEEDED(::SetThreadDescription(m_handle, name));
+}
+
+//=============================================================================
+bool CThread::ApplyAffinity ()
+{
+    GROUP_AFFINITY affinity;
+    if (m_affinity.Any())
+    {
+        if (!ToGroupAffinity(m_affinity, &affinity))
+            return false;
+    }
+    else
+    {
+        // Back to anywhere in the thread's current group
+        memset(&affinity, 0, sizeof(affinity));
+        if (!::GetThreadGroupAffinity(m_handle, &affinity))
+            return false;
+
+        const DWORD count = ::GetActiveProcessorCount(affinity.Group);
+        affinity.Mask = count >= 64 ? ~KAFFINITY(0) : (KAFFINITY(1) << count) - 1;
+    }
+
+    return ::SetThreadGroupAffinity(m_handle, &affinity, null) != 0;
+}
+
 
 
 //*****************************************************************************
@@ -244,9 +378,116 @@ uint ThreadLogicalProcessorCount ()
     return numLogicProcs;
 }
 
+//=============================================================================
+void ThreadGetCores (TArray<CpuCore> * cores)
+{
+    ASSERT(cores);
+    cores->Clear();
+
+    DWORD bytes = 0;
+    ::GetLogicalProcessorInformationEx(RelationProcessorCore, null, &bytes);
+
+    TArray<byte> buffer;
+    buffer.Resize(bytes);
+    if (!::GetLogicalProcessorInformationEx(RelationProcessorCore, (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *)buffer.Ptr(), &bytes))
+        return;
+
+    for (DWORD offset = 0; offset < bytes; )
+    {
+        const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX * info = (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *)(buffer.Ptr() + offset);
+        offset += info->Size;
+
+        CpuSet cpus;
+        for (WORD i = 0; i < info->Processor.GroupCount; ++i)
+            AddGroupMask(info->Processor.GroupMask[i], &cpus);
+        if (cpus.None())
+            continue;
+
+        PROCESSOR_NUMBER number;
+        memset(&number, 0, sizeof(number));
+        number.Group  = info->Processor.GroupMask[0].Group;
+        number.Number = BYTE(cpus.FindFirstSet() - GroupFirstCpu(number.Group));
+
+        USHORT node = 0;
+        ::GetNumaProcessorNodeEx(&number, &node);
+
+        CpuCore * core = cores->New();
+        core->cpus = cpus;
+        core->node = node;
+    }
+
+    // Ordered by node, as on other platforms
+    for (uint i = 1; i < cores->Count(); ++i)
+    {
+        const CpuCore core = (*cores)[i];
+        uint j = i;
+        for ( ; j > 0 && (*cores)[j - 1].node > core.node; --j)
+            (*cores)[j] = (*cores)[j - 1];
+        (*cores)[j] = core;
+    }
+}
+
+//=============================================================================
+uint ThreadNumaNodeCount ()
+{
+    ULONG highest = 0;
+    if (!::GetNumaHighestNodeNumber(&highest))
+        return 1;
+    return uint(highest) + 1;
+}
+
+//=============================================================================
+CpuSet ThreadNumaNodeCpus (uint node)
+{
+    CpuSet cpus;
+
+    GROUP_AFFINITY affinity;
+    memset(&affinity, 0, sizeof(affinity));
+    if (::GetNumaNodeProcessorMaskEx(USHORT(node), &affinity))
+        AddGroupMask(affinity, &cpus);
+
+    return cpus;
+}
+
+//=============================================================================
+uint ThreadCurrentNumaNode ()
+{
+    PROCESSOR_NUMBER number;
+    ::GetCurrentProcessorNumberEx(&number);
+
+    USHORT node = 0;
+    if (!::GetNumaProcessorNodeEx(&number, &node))
+        return 0;
+    return node;
+}
+
 //=============================================================================
 void ThreadSleep (Time::Delta duration)
 {
     Time::Ms ms = duration;
     ::Sleep(uint(ms));
 }
+
+//=============================================================================
+void ThreadYield ()
+{
+    ::SwitchToThread();
+}
+
+//=============================================================================
+void ThreadWaitOnAddress (std::atomic<uint32> * addr, uint32 expected)
+{
+    static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32), "Atomic must be a plain word to wait on");
+    ::WaitOnAddress((volatile VOID *)addr, &expected, sizeof(expected), INFINITE);
+}
+
+//=============================================================================
+void ThreadWakeByAddress (std::atomic<uint32> * addr, bool all)
+{
+    if (all)
+        ::WakeByAddressAll((PVOID)addr);
+    else
+        ::WakeByAddressSingle((PVOID)addr);
+}
+
+#endif // FE_THREAD_WIN32
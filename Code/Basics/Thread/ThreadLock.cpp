@@ -0,0 +1,289 @@
+#include "ThrdPch.h"
+
+//*****************************************************************************
+//
+// Constants
+//
+//*****************************************************************************
+
+const uint SPIN_COUNT        = 128;     // Pauses before a mutex waiter sleeps
+const uint TICKET_SPIN_LIMIT = 1024;    // Pauses before a ticket waiter yields
+
+
+
+//*****************************************************************************
+//
+// Helpers
+//
+//*****************************************************************************
+
+//=============================================================================
+static inline void CpuPause ()
+{
+#if FE_ARCH_X86 || FE_ARCH_X64
+    _mm_pause();
+#elif FE_ARCH_ARM && !FE_COMPILER_MSVC
+    __asm__ __volatile__("yield");
+#endif
+}
+
+//=============================================================================
+static uint SpinCount ()
+{
+    // Spinning on one processor only burns the holder's time slice
+    static const uint s_spinCount = ThreadLogicalProcessorCount() > 1 ? SPIN_COUNT : 0;
+    return s_spinCount;
+}
+
+
+
+#ifdef LOCK_STATS
+
+//*****************************************************************************
+//
+// CLockCounters
+//
+//*****************************************************************************
+
+//=============================================================================
+CLockCounters::CLockCounters () :
+    m_acquires(0),
+    m_contended(0),
+    m_sleeps(0)
+{
+}
+
+//=============================================================================
+void CLockCounters::Acquired (bool contended)
+{
+    m_acquires.fetch_add(1, std::memory_order_relaxed);
+    if (contended)
+        m_contended.fetch_add(1, std::memory_order_relaxed);
+}
+
+//=============================================================================
+LockStats CLockCounters::Get () const
+{
+    LockStats stats;
+    stats.acquires  = m_acquires.load(std::memory_order_relaxed);
+    stats.contended = m_contended.load(std::memory_order_relaxed);
+    stats.sleeps    = m_sleeps.load(std::memory_order_relaxed);
+    return stats;
+}
+
+//=============================================================================
+void CLockCounters::Reset ()
+{
+    m_acquires.store(0, std::memory_order_relaxed);
+    m_contended.store(0, std::memory_order_relaxed);
+    m_sleeps.store(0, std::memory_order_relaxed);
+}
+
+#endif // LOCK_STATS
+
+
+
+//*****************************************************************************
+//
+// CMutex
+//
+//*****************************************************************************
+
+//=============================================================================
+void CMutex::LockContended ()
+{
+    for (uint spin = SpinCount(); spin; --spin)
+    {
+        CpuPause();
+
+        uint32 expected = UNLOCKED;
+        if (m_state.load(std::memory_order_relaxed) == UNLOCKED &&
+            m_state.compare_exchange_weak(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            LOCK_STAT(m_stats.Acquired(true));
+            return;
+        }
+    }
+
+    // Marking the lock contended makes Unlock wake a sleeper. A thread that
+    // takes the lock this way cannot tell whether others still sleep, so it
+    // keeps the mark and its Unlock wakes one, possibly needlessly.
+    while (m_state.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED)
+    {
+        LOCK_STAT(m_stats.Slept());
+        ThreadWaitOnAddress(&m_state, CONTENDED);
+    }
+
+    LOCK_STAT(m_stats.Acquired(true));
+}
+
+//=============================================================================
+LockStats CMutex::GetStats () const
+{
+#ifdef LOCK_STATS
+    return m_stats.Get();
+#else
+    return LockStats();
+#endif
+}
+
+//=============================================================================
+void CMutex::ResetStats ()
+{
+    LOCK_STAT(m_stats.Reset());
+}
+
+
+
+//*****************************************************************************
+//
+// CRwLock
+//
+// Waiters announce themselves in m_sleepers before sleeping on m_state, and
+// every release re-reads m_sleepers after changing m_state. Both sides use
+// sequentially consistent operations, so either the waiter sees the new state
+// and does not sleep, or the releaser sees the waiter and wakes it.
+//
+//*****************************************************************************
+
+//=============================================================================
+void CRwLock::LockSharedContended ()
+{
+    for (uint spin = SpinCount(); ; spin = spin ? spin - 1 : 0)
+    {
+        uint32 state = m_state.load(std::memory_order_seq_cst);
+        if (!(state & WRITER) && !m_writersWaiting.load(std::memory_order_seq_cst))
+        {
+            if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                break;
+            continue;
+        }
+
+        if (spin)
+        {
+            CpuPause();
+            continue;
+        }
+
+        LOCK_STAT(m_stats.Slept());
+        Sleep(state);
+    }
+
+    LOCK_STAT(m_stats.Acquired(true));
+}
+
+//=============================================================================
+void CRwLock::LockContended ()
+{
+    // Holds off new readers until this writer is through
+    m_writersWaiting.fetch_add(1, std::memory_order_seq_cst);
+
+    for (uint spin = SpinCount(); ; spin = spin ? spin - 1 : 0)
+    {
+        uint32 state = m_state.load(std::memory_order_seq_cst);
+        if (!state)
+        {
+            if (m_state.compare_exchange_weak(state, WRITER, std::memory_order_seq_cst, std::memory_order_relaxed))
+                break;
+            continue;
+        }
+
+        if (spin)
+        {
+            CpuPause();
+            continue;
+        }
+
+        LOCK_STAT(m_stats.Slept());
+        Sleep(state);
+    }
+
+    // Readers held off by this writer may be asleep; they wait for the
+    // Unlock, which wakes everyone
+    m_writersWaiting.fetch_sub(1, std::memory_order_seq_cst);
+
+    LOCK_STAT(m_stats.Acquired(true));
+}
+
+//=============================================================================
+void CRwLock::Sleep (uint32 state)
+{
+    m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+    ThreadWaitOnAddress(&m_state, state);
+    m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+//=============================================================================
+void CRwLock::WakeAll ()
+{
+    if (m_sleepers.load(std::memory_order_seq_cst))
+        ThreadWakeByAddress(&m_state, true);
+}
+
+//=============================================================================
+LockStats CRwLock::GetStats () const
+{
+#ifdef LOCK_STATS
+    return m_stats.Get();
+#else
+    return LockStats();
+#endif
+}
+
+//=============================================================================
+void CRwLock::ResetStats ()
+{
+    LOCK_STAT(m_stats.Reset());
+}
+
+
+
+//*****************************************************************************
+//
+// CTicketLock
+//
+//*****************************************************************************
+
+//=============================================================================
+void CTicketLock::LockContended (uint32 ticket)
+{
+    uint spins = 0;
+    for (;;)
+    {
+        const uint32 serving = m_serving.load(std::memory_order_acquire);
+        if (serving == ticket)
+            break;
+
+        // Back off in proportion to the queue ahead so waiters do not all
+        // hammer the cache line on every release
+        const uint32 ahead = ticket - serving;
+        for (uint32 i = 0; i < ahead; ++i)
+            CpuPause();
+
+        spins += ahead;
+        if (spins >= TICKET_SPIN_LIMIT || !SpinCount())
+        {
+            LOCK_STAT(m_stats.Slept());
+            ThreadYield();
+            spins = 0;
+        }
+    }
+
+    LOCK_STAT(m_stats.Acquired(true));
+}
+
+//=============================================================================
+LockStats CTicketLock::GetStats () const
+{
+#ifdef LOCK_STATS
+    return m_stats.Get();
+#else
+    return LockStats();
+#endif
+}
+
+//=============================================================================
+void CTicketLock::ResetStats ()
+{
+    LOCK_STAT(m_stats.Reset());
+}
@@ -0,0 +1,586 @@
+#include "ThrdPch.h"
+
+#if FE_THREAD_POSIX
+
+//*****************************************************************************
+//
+// Validation
+//
+//*****************************************************************************
+
+//=============================================================================
+static_assert(CriticalSection::DATA_SIZE >= uint(sizeof(pthread_mutex_t)), "Not enough space to hold critical section data");
+static_assert(CriticalSection::DATA_ALIGN >= uint(alignof(pthread_mutex_t)), "Critical section data is not aligned enough");
+
+
+
+//*****************************************************************************
+//
+// Helpers
+//
+//*****************************************************************************
+
+namespace
+{
+
+// Shared by the CThread and the thread it started, and freed by whichever
+// lets go last, since a CThread may be destroyed while its thread still runs
+struct ThreadData
+{
+    CThread *         owner;
+    pthread_t         thread;
+    std::atomic<uint> refs;
+    std::atomic<bool> running;
+    bool              joined;
+    char              name[16];     // Kernel limit, including the terminator
+};
+
+struct SemaphoreData
+{
+    std::atomic<uint32> count;
+    std::atomic<uint32> waiters;
+};
+
+struct EventData
+{
+    std::atomic<uint32> signaled;
+};
+
+} // namespace
+
+//=============================================================================
+inline pthread_mutex_t * ConvertCritSec (uint8 * data)
+{
+    return (pthread_mutex_t *)data;
+}
+
+//=============================================================================
+static void FutexWait (std::atomic<uint32> * addr, uint32 expected)
+{
+    // Returns straight away if *addr no longer holds expected; callers
+    // re-check their condition either way
+    syscall(SYS_futex, (uint32 *)addr, FUTEX_WAIT_PRIVATE, expected, null, null, 0);
+}
+
+//=============================================================================
+static void FutexWake (std::atomic<uint32> * addr, sint count)
+{
+    syscall(SYS_futex, (uint32 *)addr, FUTEX_WAKE_PRIVATE, count, null, null, 0);
+}
+
+//=============================================================================
+static void ToCpuSet (const CpuSet & cpus, cpu_set_t * out)
+{
+    CPU_ZERO(out);
+    for (uint cpu : cpus)
+        CPU_SET(cpu, out);
+}
+
+//=============================================================================
+static CpuSet AllowedCpus ()
+{
+    CpuSet cpus;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    {
+        for (uint cpu = 0, count = ThreadLogicalProcessorCount(); cpu < count && cpu < THREAD_MAX_CPUS; ++cpu)
+            cpus.Set(cpu);
+        return cpus;
+    }
+
+    for (uint cpu = 0; cpu < THREAD_MAX_CPUS && cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &set))
+            cpus.Set(cpu);
+    }
+    return cpus;
+}
+
+//=============================================================================
+static bool ReadCpuList (const char path[], CpuSet * cpus)
+{
+    // Lists look like "0-3,8,10-11"
+    FILE * file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    char text[1024];
+    const bool read = fgets(text, sizeof(text), file) != null;
+    fclose(file);
+    if (!read)
+        return false;
+
+    for (const char * ptr = text; *ptr >= '0' && *ptr <= '9'; )
+    {
+        char * end;
+        const uint first = uint(strtoul(ptr, &end, 10));
+        uint last = first;
+        if (*end == '-')
+            last = uint(strtoul(end + 1, &end, 10));
+
+        for (uint cpu = first; cpu <= last && cpu < THREAD_MAX_CPUS; ++cpu)
+            cpus->Set(cpu);
+
+        ptr = *end == ',' ? end + 1 : end;
+    }
+
+    return true;
+}
+
+//=============================================================================
+static void ReleaseThreadData (void * param)
+{
+    ThreadData * data = (ThreadData *)param;
+    if (data->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete data;
+}
+
+//=============================================================================
+static void * ThreadEntryPoint (void * param)
+{
+    ThreadData * data = (ThreadData *)param;
+    ASSERT(data);
+
+    // Also runs if the thread is cancelled by Stop
+    pthread_cleanup_push(ReleaseThreadData, data);
+
+    // Named from inside so the name is in place before any of the owner's code
+    if (data->name[0])
+        pthread_setname_np(pthread_self(), data->name);
+
+    data->owner->ThreadEnter();
+    data->running.store(false, std::memory_order_release);
+
+    pthread_cleanup_pop(1);
+    return null;
+}
+
+
+
+//*****************************************************************************
+//
+// Thread
+//
+//*****************************************************************************
+
+//=============================================================================
+CThread::CThread () :
+    m_id(0),
+    m_handle(null)
+{
+    m_name[0] = 0;
+}
+
+//=============================================================================
+CThread::~CThread ()
+{
+    ThreadData * data = (ThreadData *)m_handle;
+    if (!data)
+        return;
+
+    // As on Win32, dropping the handle does not wait for the thread
+    if (!data->joined)
+        pthread_detach(data->thread);
+    ReleaseThreadData(data);
+}
+
+//=============================================================================
+void CThread::Start()
+{
+    ASSERT(!m_handle);
+
+    ThreadData * data = new ThreadData;
+    data->owner  = this;
+    data->joined = false;
+    data->refs.store(2, std::memory_order_relaxed);    // This CThread and the thread
+    data->running.store(true, std::memory_order_relaxed);
+    strncpy(data->name, m_name, array_size(data->name) - 1);
+    data->name[array_size(data->name) - 1] = 0;
+
+    // Pin through the attributes so the thread never runs elsewhere
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (m_affinity.Any())
+    {
+        cpu_set_t set;
+        ToCpuSet(m_affinity, &set);
+        pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+    }
+
+    const int error = pthread_create(&data->thread, &attr, ThreadEntryPoint, data);
+    pthread_attr_destroy(&attr);
+    if (error != 0)
+    {
+        delete data;
+        return;
+    }
+
+    m_handle = data;
+    m_id     = ThreadId(uintptr_t(data->thread));
+}
+
+//=============================================================================
+void CThread::Stop()
+{
+    ThreadData * data = (ThreadData *)m_handle;
+    if (!data)
+        return;
+
+    // Like TerminateThread this is a last resort; the thread only dies at its
+    // next cancellation point and holds on to any locks it owns
+    pthread_cancel(data->thread);
+    data->running.store(false, std::memory_order_release);
+}
+
+//=============================================================================
+void CThread::Join()
+{
+    ThreadData * data = (ThreadData *)m_handle;
+    if (!data || data->joined)
+        return;
+
+    pthread_join(data->thread, null);
+    data->joined = true;
+}
+
+//=============================================================================
+void CThread::Suspend()
+{
+    // POSIX has no way to suspend another thread
+    ASSERT(false);
+}
+
+//=============================================================================
+void CThread::Resume()
+{
+    ASSERT(false);
+}
+
+//=============================================================================
+bool CThread::IsRunning() const
+{
+    const ThreadData * data = (const ThreadData *)m_handle;
+    return data && data->running.load(std::memory_order_acquire);
+}
+
+//=============================================================================
+void CThread::SetName (const char name[])
+{
+    strncpy(m_name, name, array_size(m_name) - 1);
+    m_name[array_size(m_name) - 1] = 0;
+
+    if (m_handle)
+        ApplyName();
+}
+
+//=============================================================================
+bool CThread::SetAffinity (const CpuSet & cpus)
+{
+    m_affinity = cpus;
+    return m_handle ? ApplyAffinity() : true;
+}
+
+//=============================================================================
+bool CThread::SetNumaNode (uint node)
+{
+    const CpuSet cpus = ThreadNumaNodeCpus(node);
+    if (cpus.None())
+        return false;
+
+    return SetAffinity(cpus);
+}
+
+//=============================================================================
+bool CThread::ApplyName ()
+{
+    const ThreadData * data = (const ThreadData *)m_handle;
+
+    char name[array_size(data->name)];
+    strncpy(name, m_name, array_size(name) - 1);
+    name[array_size(name) - 1] = 0;
+
+    return pthread_setname_np(data->thread, name) == 0;
+}
+
+//=============================================================================
+bool CThread::ApplyAffinity ()
+{
+    const ThreadData * data = (const ThreadData *)m_handle;
+
+    cpu_set_t set;
+    if (m_affinity.Any())
+        ToCpuSet(m_affinity, &set);
+    else
+        ToCpuSet(AllowedCpus(), &set);
+
+    return pthread_setaffinity_np(data->thread, sizeof(set), &set) == 0;
+}
+
+
+
+//*****************************************************************************
+//
+// CriticalSection
+//
+//*****************************************************************************
+
+//=============================================================================
+CriticalSection::CriticalSection ()
+{
+    // Recursive to match Win32 critical sections
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(ConvertCritSec(m_data), &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+//=============================================================================
+CriticalSection::~CriticalSection ()
+{
+    pthread_mutex_destroy(ConvertCritSec(m_data));
+}
+
+//=============================================================================
+bool CriticalSection::TryEnter ()
+{
+    return pthread_mutex_trylock(ConvertCritSec(m_data)) == 0;
+}
+
+//=============================================================================
+void CriticalSection::Enter ()
+{
+    pthread_mutex_lock(ConvertCritSec(m_data));
+}
+
+//=============================================================================
+void CriticalSection::Leave ()
+{
+    pthread_mutex_unlock(ConvertCritSec(m_data));
+}
+
+
+//*****************************************************************************
+//
+// Semaphore
+//
+//*****************************************************************************
+
+//=============================================================================
+Semaphore::Semaphore (uint32_t initialValue)
+{
+    SemaphoreData * data = new SemaphoreData;
+    data->count.store(initialValue, std::memory_order_relaxed);
+    data->waiters.store(0, std::memory_order_relaxed);
+    m_handle = data;
+}
+
+//=============================================================================
+Semaphore::~Semaphore ()
+{
+    delete (SemaphoreData *)m_handle;
+}
+
+//=============================================================================
+bool Semaphore::Wait ()
+{
+    SemaphoreData * data = (SemaphoreData *)m_handle;
+
+    for (;;)
+    {
+        uint32 count = data->count.load(std::memory_order_relaxed);
+        while (count > 0)
+        {
+            if (data->count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+
+        data->waiters.fetch_add(1, std::memory_order_seq_cst);
+        FutexWait(&data->count, 0);
+        data->waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+//=============================================================================
+void Semaphore::Post ()
+{
+    SemaphoreData * data = (SemaphoreData *)m_handle;
+
+    data->count.fetch_add(1, std::memory_order_seq_cst);
+    if (data->waiters.load(std::memory_order_seq_cst))
+        FutexWake(&data->count, 1);
+}
+
+
+//*****************************************************************************
+//
+// Event
+//
+//*****************************************************************************
+
+//=============================================================================
+Event::Event (bool initialState)
+{
+    EventData * data = new EventData;
+    data->signaled.store(initialState ? 1 : 0, std::memory_order_relaxed);
+    m_handle = data;
+}
+
+//=============================================================================
+Event::~Event ()
+{
+    delete (EventData *)m_handle;
+}
+
+//=============================================================================
+void Event::Wait ()
+{
+    EventData * data = (EventData *)m_handle;
+
+    // Auto reset: exactly one waiter consumes each signal
+    while (!data->signaled.exchange(0, std::memory_order_acquire))
+        FutexWait(&data->signaled, 0);
+}
+
+//=============================================================================
+void Event::Post ()
+{
+    EventData * data = (EventData *)m_handle;
+
+    data->signaled.store(1, std::memory_order_release);
+    FutexWake(&data->signaled, 1);
+}
+
+
+
+//*****************************************************************************
+//
+// Functions
+//
+//*****************************************************************************
+
+//=============================================================================
+uint ThreadLogicalProcessorCount ()
+{
+    // Only count the processors this process may actually run on
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        return uint(CPU_COUNT(&set));
+
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? uint(count) : 1;
+}
+
+//=============================================================================
+void ThreadSleep (Time::Delta duration)
+{
+    const sint64 ns = Max(duration.GetRaw(), sint64(0));
+
+    timespec remaining;
+    remaining.tv_sec  = time_t(ns / Time::NS_PER_SECOND);
+    remaining.tv_nsec = long(ns % Time::NS_PER_SECOND);
+
+    // Resume after signal interruptions with whatever time is left
+    while (nanosleep(&remaining, &remaining) != 0 && errno == EINTR)
+        ;
+}
+
+//=============================================================================
+void ThreadYield ()
+{
+    sched_yield();
+}
+
+//=============================================================================
+void ThreadGetCores (TArray<CpuCore> * cores)
+{
+    ASSERT(cores);
+    cores->Clear();
+
+    const CpuSet allowed = AllowedCpus();
+    for (uint node = 0, nodeCount = ThreadNumaNodeCount(); node < nodeCount; ++node)
+    {
+        CpuSet nodeCpus = ThreadNumaNodeCpus(node);
+        nodeCpus &= allowed;
+
+        for (uint cpu : nodeCpus)
+        {
+            char path[128];
+            snprintf(path, array_size(path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", cpu);
+
+            CpuSet siblings;
+            if (!ReadCpuList(path, &siblings))
+                siblings.Set(cpu);
+            siblings &= allowed;
+
+            // Each core is listed once, by its lowest processor
+            if (siblings.FindFirstSet() != cpu)
+                continue;
+
+            CpuCore * core = cores->New();
+            core->cpus = siblings;
+            core->node = node;
+        }
+    }
+}
+
+//=============================================================================
+uint ThreadNumaNodeCount ()
+{
+    // Same list format as processors. Node numbers can have gaps, so count
+    // up to the highest.
+    CpuSet nodes;
+    if (!ReadCpuList("/sys/devices/system/node/online", &nodes) || nodes.None())
+        return 1;
+
+    uint highest = 0;
+    for (uint node : nodes)
+        highest = node;
+    return highest + 1;
+}
+
+//=============================================================================
+CpuSet ThreadNumaNodeCpus (uint node)
+{
+    char path[64];
+    snprintf(path, array_size(path), "/sys/devices/system/node/node%u/cpulist", node);
+
+    CpuSet cpus;
+    if (!ReadCpuList(path, &cpus) && node == 0)
+        cpus = AllowedCpus();   // Kernel without NUMA support, one node holds everything
+
+    return cpus;
+}
+
+//=============================================================================
+uint ThreadCurrentNumaNode ()
+{
+    const sint cpu = sched_getcpu();
+    if (cpu < 0)
+        return 0;
+
+    for (uint node = 0, count = ThreadNumaNodeCount(); node < count; ++node)
+    {
+        if (ThreadNumaNodeCpus(node).Get(uint(cpu)))
+            return node;
+    }
+    return 0;
+}
+
+//=============================================================================
+void ThreadWaitOnAddress (std::atomic<uint32> * addr, uint32 expected)
+{
+    static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32), "Atomic must be a plain word to wait on");
+    FutexWait(addr, expected);
+}
+
+//=============================================================================
+void ThreadWakeByAddress (std::atomic<uint32> * addr, bool all)
+{
+    FutexWake(addr, all ? INT_MAX : 1);
+}
+
+#endif // FE_THREAD_POSIX
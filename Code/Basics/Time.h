@@ -1,9 +1,33 @@
 #ifndef BASICS_TIME_H
 #define BASICS_TIME_H
 
+// Read real time from the cycle counter where it is reliable, see GetRealTime
+//#define TIME_RDTSC
+
+class CTimerWheel;
+
 namespace Time
 {
 
+//*****************************************************************************
+//
+// Constants
+//
+// Points and deltas are whole nanoseconds. Points count from an arbitrary
+// epoch, fixed for the life of the process, so only the difference between
+// two points means anything. 64 bits of nanoseconds last for centuries of
+// uptime with no loss of precision, unlike seconds in a float64, which lose a
+// bit of resolution every time the uptime doubles.
+//
+//*****************************************************************************
+
+const sint64 NS_PER_US     = 1000;
+const sint64 NS_PER_MS     = 1000 * NS_PER_US;
+const sint64 NS_PER_SECOND = 1000 * NS_PER_MS;
+const sint64 NS_PER_MINUTE = 60 * NS_PER_SECOND;
+
+
+
 //*****************************************************************************
 //
 // Forwards
@@ -26,22 +50,23 @@ public: // Construction
 
     Point ();
     Point (const Point & rhs);
-    explicit Point (float64 time);
+    explicit Point (float64 seconds);
+
+    static Point FromNs (sint64 ns);
 
 public: // Accessors
 
-    float64 GetRaw () const { return m_time; }
+    sint64  GetRaw () const { return m_ns; }    // Nanoseconds
+    float64 GetSeconds () const { return float64(m_ns) / float64(NS_PER_SECOND); }
 
 public: // Operators
 
     Point & operator+= (const Delta & rhs);
     Point & operator-= (const Delta & rhs);
-    Point & operator*= (const Delta & rhs);
-    Point & operator/= (const Delta & rhs);
 
 private: // Data
 
-    float64 m_time;
+    sint64 m_ns;
 };
 
 
@@ -60,26 +85,32 @@ public: // Construction
     Delta (const Delta & rhs);
     explicit Delta (float64 seconds);
 
+    static Delta FromNs (sint64 ns);
+
     Delta & operator= (const Delta & rhs);
 
 public: // Conversion
 
-	explicit operator float32 () const { return float32(m_duration); }
-    explicit operator float64 () const { return m_duration; }
-    explicit operator uint () const { return FloatToUint(m_duration); }
-    float64 GetRaw () const { return m_duration; }
-    float32 GetSeconds () const { return (float32)m_duration; }
+    explicit operator float32 () const { return float32(ToSeconds()); }
+    explicit operator float64 () const { return ToSeconds(); }
+    explicit operator uint () const { return uint(m_ns / NS_PER_SECOND); }
+    sint64  GetRaw () const { return m_ns; }    // Nanoseconds
+    float32 GetSeconds () const { return float32(ToSeconds()); }
 
 public: // Operations
 
     Delta & operator+= (const Delta & rhs);
     Delta & operator-= (const Delta & rhs);
-    Delta & operator*= (const Delta & rhs);
-    Delta & operator/= (const Delta & rhs);
+    Delta & operator*= (float64 scalar);
+    Delta & operator/= (float64 scalar);
+
+protected: // Helpers
+
+    float64 ToSeconds () const { return float64(m_ns) / float64(NS_PER_SECOND); }
 
 protected: // Data
 
-    float64 m_duration;
+    sint64 m_ns;
 };
 
 
@@ -120,9 +151,12 @@ public:
 
     static const uint MS_PER_SECOND = 1000;
 
-	explicit operator float32 () const { return float32(m_duration * MS_PER_SECOND); }
-    explicit operator float64 () const { return m_duration * MS_PER_SECOND; }
-    explicit operator uint () const { return FloatToUint(m_duration * MS_PER_SECOND); }
+    explicit operator float32 () const { return float32(ToMs()); }
+    explicit operator float64 () const { return ToMs(); }
+    explicit operator uint () const { return uint(m_ns / NS_PER_MS); }
+
+private:
+    float64 ToMs () const { return float64(m_ns) / float64(NS_PER_MS); }
 };
 
 
@@ -153,7 +187,9 @@ public:
 Delta operator- (const Point & a, const Point & b);
 Point operator+ (const Point & p, const Delta & d);
 Point operator+ (const Delta & d, const Point & p);
+Point operator- (const Point & p, const Delta & d);
 Delta operator+ (const Delta & a, const Delta & b);
+Delta operator- (const Delta & a, const Delta & b);
 
 Delta operator* (float64 scalar, const Delta & d);
 Delta operator* (const Delta & a, float64 scalar);
@@ -166,6 +202,13 @@ bool operator >= (const Delta & a, const Delta & b);
 bool operator == (const Delta & a, const Delta & b);
 bool operator != (const Delta & a, const Delta & b);
 
+bool operator <  (const Point & a, const Point & b);
+bool operator <= (const Point & a, const Point & b);
+bool operator >  (const Point & a, const Point & b);
+bool operator >= (const Point & a, const Point & b);
+bool operator == (const Point & a, const Point & b);
+bool operator != (const Point & a, const Point & b);
+
 Delta Min (Delta a, Delta b);
 Delta Max (Delta a, Delta b);
 
@@ -177,9 +220,19 @@ Delta Max (Delta a, Delta b);
 //
 //*****************************************************************************
 
+// Once per frame. Also starts a new frame for frame arenas, see MemFrameAdvance.
 void Update ();
 
-// Real-time
+// Real-time, from the OS monotonic clock: QueryPerformanceCounter on Windows,
+// clock_gettime(CLOCK_MONOTONIC) elsewhere. Never goes backwards, and does not
+// jump when the wall clock is changed.
+//
+// With TIME_RDTSC defined, x86 machines with an invariant TSC read the cycle
+// counter instead, which avoids the OS call on every read. Its rate
+// is measured against the OS clock and the two are re-anchored on every
+// Update, so the fast clock cannot drift away from the OS one. The OS clock
+// is used on other machines, and until an Update comes long enough after
+// startup to measure the rate.
 Point GetRealTime ();
 
 // Frame-time
@@ -194,6 +247,11 @@ Delta   GetGameDelta ();
 bool    IsGamePaused ();
 void    SetGamePaused (bool paused);
 
+// Timers advanced by Update, see CTimerWheel. Game timers follow game time,
+// so they stop while the game is paused and speed up with the game scale.
+CTimerWheel & GetGameTimers ();
+CTimerWheel & GetRealTimers ();
+
 } // namespace Time
 
 
@@ -236,4 +294,90 @@ private:
     Time::Point m_lastTime;
 };
 
+
+
+//*****************************************************************************
+//
+// CTimerWheel
+//
+// Callbacks to run after a delay: cooldowns, timeouts, respawns, keepalives
+// and retransmits. A hierarchical timing wheel (Varghese and Lauck): time is
+// cut into ticks of a fixed resolution, and each of four levels of 256 slots
+// spans 256 times as long as the level below. A timer is filed in the lowest
+// level whose span reaches its expiry and moves down a level each time the
+// wheel turns past the slot it is in. Schedule and Cancel are O(1), and
+// Advance only visits slots that hold timers, so a long pause costs no more
+// than a short one.
+//
+// Delays count from the wheel's time, which is the time passed to the last
+// Advance rounded down to a tick. Timers fire in expiry order during Advance,
+// never early and at most one tick late. Callbacks may schedule and cancel
+// timers, including rescheduling themselves; a zero delay fires on the next
+// tick. Delays beyond the top level, about 50 days at the default
+// resolution, wait in an overflow list that is refiled each time it turns.
+//
+// Not thread-safe. The wheels Time owns fire on the thread that calls
+// Time::Update; a system running on a thread of its own, such as networking,
+// keeps its own wheel and advances it there.
+//
+//*****************************************************************************
+
+typedef uint64                 TimerId;     // Zero is never a valid id
+typedef std::function<void ()> FTimer;
+
+class CTimerWheel
+{
+public:
+    explicit CTimerWheel (Time::Point start, Time::Delta resolution = Time::Ms(1));
+    ~CTimerWheel ();
+
+    TimerId     Schedule (Time::Delta delay, FTimer fn);
+    TimerId     ScheduleAt (Time::Point time, FTimer fn);
+    bool        Cancel (TimerId id);        // False once it has fired or been cancelled
+    bool        IsPending (TimerId id) const;
+
+    // Fires every timer due by now. Time must not go backwards.
+    void        Advance (Time::Point now);
+
+    Time::Point Now () const;
+    uint        PendingCount () const { return m_pendingCount; }
+
+private:
+    CLASS_NO_COPY(CTimerWheel);
+
+    static const uint LEVEL_BITS  = 8;
+    static const uint LEVEL_SLOTS = 1 << LEVEL_BITS;
+    static const uint LEVEL_COUNT = 4;
+    static const uint SLOT_COUNT  = LEVEL_COUNT * LEVEL_SLOTS + 2;     // Plus the overflow and firing lists
+
+    struct Timer
+    {
+        FTimer fn;
+        uint64 expiry;          // Tick
+        uint32 next;
+        uint32 prev;
+        uint32 generation;      // Bumped on release so stale ids miss
+        uint32 slot;
+    };
+
+    TimerId Insert (uint64 expiry, FTimer fn);
+    void    Release (uint32 index);
+    uint    SlotFor (uint64 expiry) const;
+    void    Link (uint32 index, uint slot);
+    void    Unlink (uint32 index);
+    uint    NextOccupied (uint level, uint first, uint last) const;
+    uint64  NextCascade () const;
+    void    Refile (uint slot);
+    void    Cascade ();
+    void    Fire (uint slot);
+
+    TArray<Timer> m_timers;
+    uint32        m_freeHead;
+    uint32        m_heads[SLOT_COUNT];
+    uint64        m_occupied[LEVEL_COUNT][LEVEL_SLOTS / 64];    // Slots holding timers
+    uint64        m_tick;
+    sint64        m_resolution;                     // Nanoseconds per tick
+    uint          m_pendingCount;
+};
+
 #endif // BASICS_TIME_H
\ No newline at end of file
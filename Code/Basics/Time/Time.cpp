@@ -1,6 +1,13 @@
 #include "TimePch.h"
 
-#pragma comment(lib, "Winmm.lib")
+#if FE_OS_WINDOWS
+#   pragma comment(lib, "Winmm.lib")
+#endif
+
+// The cycle counter is only used where it is known to tick at a fixed rate
+#if defined(TIME_RDTSC) && (FE_ARCH_X86 || FE_ARCH_X64)
+#   define TIME_TSC
+#endif
 
 namespace Time
 {
@@ -11,9 +18,11 @@ namespace Time
 //
 //*****************************************************************************
 
-const float32 SECONDS_PER_MINUTE = 60.0f;
-const float32 SECONDS_PER_MILLI = 1.0f / 1000.0f;
-const Delta   MAX_FRAME_TIME(1.0 / 30.0);
+const Delta MAX_FRAME_TIME = Delta::FromNs(NS_PER_SECOND / 30);
+
+#ifdef TIME_TSC
+const sint64 TSC_CALIBRATE_TIME = 50 * NS_PER_MS;   // Shortest span the rate is measured over
+#endif
 
 
 
@@ -23,7 +32,30 @@ const Delta   MAX_FRAME_TIME(1.0 / 30.0);
 //
 //*****************************************************************************
 
-static LARGE_INTEGER s_frequency;
+#ifdef TIME_TSC
+
+namespace
+{
+
+// Maps the cycle counter onto the OS clock. Written by Update, read by any
+// thread: sequence is odd while a write is in progress, and readers retry if
+// it changed while they read.
+struct TscAnchor
+{
+    std::atomic<uint32>  sequence;
+    std::atomic<uint64>  tsc;
+    std::atomic<sint64>  ns;
+    std::atomic<float64> nsPerTick;     // Zero until calibrated
+};
+
+} // namespace
+
+static TscAnchor s_tscAnchor;
+static bool      s_tscInvariant;
+static uint64    s_tscStart;
+static sint64    s_tscStartNs;
+
+#endif // TIME_TSC
 
 static Point    s_framePoint;
 static Delta    s_frameDelta;
@@ -33,6 +65,9 @@ static Delta    s_gameDelta;
 static float32  s_gameScale = 1.0f;
 static bool     s_gameIsPause = false;
 
+static CTimerWheel s_gameTimers(Point::FromNs(0));
+static CTimerWheel s_realTimers(GetRealTime());
+
 //struct CManager
 //{
 //    CManager ();
@@ -52,53 +87,202 @@ static bool     s_gameIsPause = false;
 
 //*****************************************************************************
 //
-// Point
+// Helpers
 //
 //*****************************************************************************
 
 //=============================================================================
-Point::Point () :
-    m_time(0.0f)
+static sint64 SecondsToNs (float64 seconds)
 {
+    // Rounded to nearest so that values like Ms(8.0) come out exact
+    const float64 ns = seconds * float64(NS_PER_SECOND);
+    return FloatToSint64(ns < 0.0 ? ns - 0.5 : ns + 0.5);
 }
 
 //=============================================================================
-Point::Point (const Point & rhs) :
-    m_time(rhs.m_time)
+static sint64 ScaleNs (sint64 ns, float64 scalar)
 {
+    const float64 scaled = float64(ns) * scalar;
+    return FloatToSint64(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
 }
 
+#if FE_OS_WINDOWS
+
 //=============================================================================
-Point::Point (float64 time) :
-    m_time(time)
+static sint64 QueryFrequency ()
 {
+    LARGE_INTEGER frequency;
+    ::QueryPerformanceFrequency(&frequency);
+    return frequency.QuadPart;
 }
 
 //=============================================================================
-Point & Point::operator+= (const Delta & rhs)
+static sint64 ReadOsClock ()
 {
-    m_time += rhs.GetRaw();
-    return *this;
+    // Queried on first use so that real time works during static init
+    static const sint64 s_frequency = QueryFrequency();
+
+    LARGE_INTEGER counter;
+    ::QueryPerformanceCounter(&counter);
+
+    // Whole seconds and the remainder separately, so the multiply cannot
+    // overflow however long the machine has been up
+    const sint64 seconds   = counter.QuadPart / s_frequency;
+    const sint64 remainder = counter.QuadPart % s_frequency;
+    return seconds * NS_PER_SECOND + remainder * NS_PER_SECOND / s_frequency;
 }
 
+#else
+
 //=============================================================================
-Point & Point::operator-= (const Delta & rhs)
+static sint64 ReadOsClock ()
 {
-    m_time -= rhs.GetRaw();
-    return *this;
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return sint64(now.tv_sec) * NS_PER_SECOND + sint64(now.tv_nsec);
+}
+
+#endif
+
+#ifdef TIME_TSC
+
+//=============================================================================
+static bool HasInvariantTsc ()
+{
+    // CPUID 0x80000007, EDX bit 8: the counter ticks at a constant rate
+    // through frequency changes and sleep states, on every core
+#if FE_COMPILER_MSVC
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if (uint(regs[0]) < 0x80000007)
+        return false;
+
+    __cpuid(regs, 0x80000007);
+    return (uint(regs[3]) >> 8) & 1;
+#else
+    uint eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+        return false;
+
+    return (edx >> 8) & 1;
+#endif
+}
+
+//=============================================================================
+static sint64 ReadClock ()
+{
+    for (;;)
+    {
+        const uint32 sequence = s_tscAnchor.sequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+            continue;
+
+        const float64 nsPerTick = s_tscAnchor.nsPerTick.load(std::memory_order_relaxed);
+        const uint64  tsc       = s_tscAnchor.tsc.load(std::memory_order_relaxed);
+        const sint64  ns        = s_tscAnchor.ns.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s_tscAnchor.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        if (nsPerTick == 0.0)
+            return ReadOsClock();
+
+        return ns + sint64(float64(__rdtsc() - tsc) * nsPerTick);
+    }
+}
+
+//=============================================================================
+static void UpdateTscAnchor ()
+{
+    if (!s_tscInvariant)
+        return;
+
+    const uint64 tsc = __rdtsc();
+    const sint64 now = ReadOsClock();
+    if (now - s_tscStartNs < TSC_CALIBRATE_TIME)
+        return;
+
+    // Measured over everything since startup, so the rate keeps improving
+    const float64 nsPerTick = float64(now - s_tscStartNs) / float64(tsc - s_tscStart);
+
+    // Snap back to the OS clock, unless the fast clock has already run ahead
+    // of it: time must not go backwards
+    sint64 ns = now;
+    const float64 lastNsPerTick = s_tscAnchor.nsPerTick.load(std::memory_order_relaxed);
+    if (lastNsPerTick != 0.0)
+    {
+        const uint64 lastTsc = s_tscAnchor.tsc.load(std::memory_order_relaxed);
+        const sint64 lastNs  = s_tscAnchor.ns.load(std::memory_order_relaxed);
+        ns = ::Max(ns, lastNs + sint64(float64(tsc - lastTsc) * lastNsPerTick));
+    }
+
+    const uint32 sequence = s_tscAnchor.sequence.load(std::memory_order_relaxed);
+    s_tscAnchor.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    s_tscAnchor.tsc.store(tsc, std::memory_order_relaxed);
+    s_tscAnchor.ns.store(ns, std::memory_order_relaxed);
+    s_tscAnchor.nsPerTick.store(nsPerTick, std::memory_order_relaxed);
+
+    s_tscAnchor.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+#else
+
+//=============================================================================
+static sint64 ReadClock ()
+{
+    return ReadOsClock();
+}
+
+#endif // TIME_TSC
+
+
+
+//*****************************************************************************
+//
+// Point
+//
+//*****************************************************************************
+
+//=============================================================================
+Point::Point () :
+    m_ns(0)
+{
+}
+
+//=============================================================================
+Point::Point (const Point & rhs) :
+    m_ns(rhs.m_ns)
+{
+}
+
+//=============================================================================
+Point::Point (float64 seconds) :
+    m_ns(SecondsToNs(seconds))
+{
+}
+
+//=============================================================================
+Point Point::FromNs (sint64 ns)
+{
+    Point point;
+    point.m_ns = ns;
+    return point;
 }
 
 //=============================================================================
-Point & Point::operator*= (const Delta & rhs)
+Point & Point::operator+= (const Delta & rhs)
 {
-    m_time *= rhs.GetRaw();
+    m_ns += rhs.GetRaw();
     return *this;
 }
 
 //=============================================================================
-Point & Point::operator/= (const Delta & rhs)
+Point & Point::operator-= (const Delta & rhs)
 {
-    m_time /= rhs.GetRaw();
+    m_ns -= rhs.GetRaw();
     return *this;
 }
 
@@ -112,54 +296,62 @@ Point & Point::operator/= (const Delta & rhs)
 
 //=============================================================================
 Delta::Delta () :
-    m_duration(0.0f)
+    m_ns(0)
 {
 }
 
 //=============================================================================
 Delta::Delta (const Delta & rhs) :
-    m_duration(rhs.m_duration)
+    m_ns(rhs.m_ns)
 {
 }
 
 //=============================================================================
 Delta::Delta (float64 seconds) :
-    m_duration(seconds)
+    m_ns(SecondsToNs(seconds))
 {
 }
 
+//=============================================================================
+Delta Delta::FromNs (sint64 ns)
+{
+    Delta delta;
+    delta.m_ns = ns;
+    return delta;
+}
+
 //=============================================================================
 Delta & Delta::operator= (const Delta & rhs)
 {
-    m_duration = rhs.m_duration;
+    m_ns = rhs.m_ns;
     return *this;
 }
 
 //=============================================================================
 Delta & Delta::operator+= (const Delta & rhs)
 {
-    m_duration += rhs.m_duration;
+    m_ns += rhs.m_ns;
     return *this;
 }
 
 //=============================================================================
 Delta & Delta::operator-= (const Delta & rhs)
 {
-    m_duration -= rhs.m_duration;
+    m_ns -= rhs.m_ns;
     return *this;
 }
 
 //=============================================================================
-Delta & Delta::operator*= (const Delta & rhs)
+Delta & Delta::operator*= (float64 scalar)
 {
-    m_duration *= rhs.m_duration;
+    m_ns = ScaleNs(m_ns, scalar);
     return *this;
 }
 
 //=============================================================================
-Delta & Delta::operator/= (const Delta & rhs)
+Delta & Delta::operator/= (float64 scalar)
 {
-    m_duration /= rhs.m_duration;
+    m_ns = ScaleNs(m_ns, 1.0 / scalar);
     return *this;
 }
 
@@ -179,13 +371,13 @@ Seconds::Seconds (float64 seconds) :
 
 //=============================================================================
 Seconds::Seconds (uint seconds) :
-    Delta(seconds)
+    Delta(Delta::FromNs(sint64(seconds) * NS_PER_SECOND))
 {
 }
 
 //=============================================================================
 Seconds::Seconds (sint seconds) :
-    Delta(seconds)
+    Delta(Delta::FromNs(sint64(seconds) * NS_PER_SECOND))
 {
 }
 
@@ -199,19 +391,19 @@ Seconds::Seconds (sint seconds) :
 
 //=============================================================================
 Ms::Ms (float64 ms) :
-    Delta(ms * SECONDS_PER_MILLI)
+    Delta(Delta::FromNs(ScaleNs(NS_PER_MS, ms)))
 {
 }
 
 //=============================================================================
 Ms::Ms (uint ms) :
-    Delta(ms * SECONDS_PER_MILLI)
+    Delta(Delta::FromNs(sint64(ms) * NS_PER_MS))
 {
 }
 
 //=============================================================================
 Ms::Ms (sint ms) :
-    Delta(ms * SECONDS_PER_MILLI)
+    Delta(Delta::FromNs(sint64(ms) * NS_PER_MS))
 {
 }
 
@@ -224,20 +416,20 @@ Ms::Ms (sint ms) :
 //*****************************************************************************
 
 //=============================================================================
-Minutes::Minutes (float64 ms) :
-    Delta(ms * SECONDS_PER_MINUTE)
+Minutes::Minutes (float64 mins) :
+    Delta(Delta::FromNs(ScaleNs(NS_PER_MINUTE, mins)))
 {
 }
 
 //=============================================================================
-Minutes::Minutes (uint ms) :
-    Delta(ms * SECONDS_PER_MINUTE)
+Minutes::Minutes (uint mins) :
+    Delta(Delta::FromNs(sint64(mins) * NS_PER_MINUTE))
 {
 }
 
 //=============================================================================
-Minutes::Minutes (sint ms) :
-    Delta(ms * SECONDS_PER_MINUTE)
+Minutes::Minutes (sint mins) :
+    Delta(Delta::FromNs(sint64(mins) * NS_PER_MINUTE))
 {
 }
 
@@ -253,44 +445,56 @@ Minutes::Minutes (sint ms) :
 //=============================================================================
 Delta operator- (const Point & a, const Point & b)
 {
-    return Delta(a.GetRaw() - b.GetRaw());
+    return Delta::FromNs(a.GetRaw() - b.GetRaw());
 }
 
 //=============================================================================
 Point operator+ (const Point & p, const Delta & d)
 {
-    return Point(p.GetRaw() + d.GetRaw());
+    return Point::FromNs(p.GetRaw() + d.GetRaw());
 }
 
 //=============================================================================
 Point operator+ (const Delta & d, const Point & p)
 {
-    return Point(p.GetRaw() + d.GetRaw());
+    return Point::FromNs(p.GetRaw() + d.GetRaw());
+}
+
+//=============================================================================
+Point operator- (const Point & p, const Delta & d)
+{
+    return Point::FromNs(p.GetRaw() - d.GetRaw());
 }
 
 //=============================================================================
 Delta operator+ (const Delta & a, const Delta & b)
 {
-    return Delta(a.GetRaw() + b.GetRaw());
+    return Delta::FromNs(a.GetRaw() + b.GetRaw());
+}
+
+//=============================================================================
+Delta operator- (const Delta & a, const Delta & b)
+{
+    return Delta::FromNs(a.GetRaw() - b.GetRaw());
 }
 
 
 //=============================================================================
 Delta operator* (float64 scalar, const Delta & d)
 {
-    return Delta(d.GetRaw() * scalar);
+    return Delta::FromNs(ScaleNs(d.GetRaw(), scalar));
 }
 
 //=============================================================================
 Delta operator* (const Delta & d, float64 scalar)
 {
-    return Delta(d.GetRaw() * scalar);
+    return Delta::FromNs(ScaleNs(d.GetRaw(), scalar));
 }
 
 //=============================================================================
 Delta operator/ (const Delta & d, float64 scalar)
 {
-    return Delta(d.GetRaw() / scalar);
+    return Delta::FromNs(ScaleNs(d.GetRaw(), 1.0 / scalar));
 }
 
 //=============================================================================
@@ -329,16 +533,52 @@ bool operator != (const Delta & a, const Delta & b)
     return a.GetRaw() != b.GetRaw();
 }
 
+//=============================================================================
+bool operator < (const Point & a, const Point & b)
+{
+    return a.GetRaw() < b.GetRaw();
+}
+
+//=============================================================================
+bool operator <= (const Point & a, const Point & b)
+{
+    return a.GetRaw() <= b.GetRaw();
+}
+
+//=============================================================================
+bool operator > (const Point & a, const Point & b)
+{
+    return a.GetRaw() > b.GetRaw();
+}
+
+//=============================================================================
+bool operator >= (const Point & a, const Point & b)
+{
+    return a.GetRaw() >= b.GetRaw();
+}
+
+//=============================================================================
+bool operator == (const Point & a, const Point & b)
+{
+    return a.GetRaw() == b.GetRaw();
+}
+
+//=============================================================================
+bool operator != (const Point & a, const Point & b)
+{
+    return a.GetRaw() != b.GetRaw();
+}
+
 //=============================================================================
 Delta Min (Delta a, Delta b)
 {
-    return Delta(::Min(a.GetRaw(), b.GetRaw()));
+    return Delta::FromNs(::Min(a.GetRaw(), b.GetRaw()));
 }
 
 //=============================================================================
 Delta Max (Delta a, Delta b)
 {
- return Delta(::Max(a.GetRaw(), b.GetRaw()));
+    return Delta::FromNs(::Max(a.GetRaw(), b.GetRaw()));
 }
 
 
@@ -351,38 +591,52 @@ Delta Max (Delta a, Delta b)
 //=============================================================================
 AUTO_INIT_FUNC(TimeInit)
 {
-    ::QueryPerformanceFrequency(&s_frequency);
+#if FE_OS_WINDOWS
     timeBeginPeriod(1);
-    
+#endif
+
+#ifdef TIME_TSC
+    s_tscInvariant = HasInvariantTsc();
+    s_tscStart     = __rdtsc();
+    s_tscStartNs   = ReadOsClock();
+#endif
+
     s_framePoint = GetRealTime();
 }
 
 //=============================================================================
 void Uninitialize ()
 {
+#if FE_OS_WINDOWS
     timeEndPeriod(1);
+#endif
 }
 
 //=============================================================================
 void Update ()
 {
+    Profile::MarkFrame();
+    MemFrameAdvance();
+
+#ifdef TIME_TSC
+    UpdateTscAnchor();
+#endif
+
     Point lastPoint = s_framePoint;
     s_framePoint = GetRealTime();
     s_frameDelta = s_framePoint - lastPoint;
 
     s_gameDelta = Min(s_frameDelta, MAX_FRAME_TIME) * (s_gameIsPause ? 0.0f : s_gameScale);
     s_gamePoint += s_gameDelta;
+
+    s_realTimers.Advance(s_framePoint);
+    s_gameTimers.Advance(s_gamePoint);
 }
 
 //=============================================================================
 Point GetRealTime ()
 {
-    LARGE_INTEGER time;
-    ::QueryPerformanceCounter(&time);
-
-    const float64 f = static_cast<float64>(time.QuadPart) / static_cast<float64>(s_frequency.QuadPart);
-
-    return Point(f);
+    return Point::FromNs(ReadClock());
 }
 
 //=============================================================================
@@ -433,6 +687,18 @@ void SetGamePaused (bool paused)
     s_gameIsPause = paused;
 }
 
+//=============================================================================
+CTimerWheel & GetGameTimers ()
+{
+    return s_gameTimers;
+}
+
+//=============================================================================
+CTimerWheel & GetRealTimers ()
+{
+    return s_realTimers;
+}
+
 } // namespace Time
 
 
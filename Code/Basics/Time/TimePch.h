@@ -3,10 +3,27 @@
 #endif
 #define TIMEPCH_H
 
+#include <atomic>
+#include <cstring>
 
-#include "Windows.h"
-#include "mmsystem.h"
+#include "platform.h"
+
+#if FE_OS_WINDOWS
+#   include "Windows.h"
+#   include "mmsystem.h"
+#else
+#   include <ctime>
+#endif
+
+#if FE_ARCH_X86 || FE_ARCH_X64
+#   if FE_COMPILER_MSVC
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#       include <x86intrin.h>
+#   endif
+#endif
 
 #include "Ferrite.h"
 #include "Basics/Time.h"
-
+#include "Basics/Profile.h"
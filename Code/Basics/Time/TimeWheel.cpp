@@ -0,0 +1,320 @@
+#include "TimePch.h"
+
+//*****************************************************************************
+//
+// Constants
+//
+//*****************************************************************************
+
+const uint32 INDEX_NONE    = ~uint32(0);
+const uint   SLOT_OVERFLOW = 4 * 256;           // After the levels
+const uint   SLOT_FIRING   = SLOT_OVERFLOW + 1;
+const uint32 SLOT_FREE     = ~uint32(0);
+
+
+
+//*****************************************************************************
+//
+// CTimerWheel
+//
+//*****************************************************************************
+
+//=============================================================================
+CTimerWheel::CTimerWheel (Time::Point start, Time::Delta resolution) :
+    m_freeHead(INDEX_NONE),
+    m_tick(0),
+    m_resolution(resolution.GetRaw()),
+    m_pendingCount(0)
+{
+    static_assert(SLOT_OVERFLOW == LEVEL_COUNT * LEVEL_SLOTS, "Overflow list must follow the levels");
+    static_assert(SLOT_FIRING + 1 == SLOT_COUNT, "Firing list must be last");
+    ASSERT(m_resolution > 0);
+    ASSERT(start.GetRaw() >= 0);
+
+    m_tick = uint64(start.GetRaw() / m_resolution);
+
+    for (uint32 & head : m_heads)
+        head = INDEX_NONE;
+    memset(m_occupied, 0, sizeof(m_occupied));
+}
+
+//=============================================================================
+CTimerWheel::~CTimerWheel ()
+{
+}
+
+//=============================================================================
+TimerId CTimerWheel::Schedule (Time::Delta delay, FTimer fn)
+{
+    // Rounded up so the timer never fires early
+    const sint64 ns    = Max(delay.GetRaw(), sint64(0));
+    const uint64 ticks = uint64((ns + m_resolution - 1) / m_resolution);
+    return Insert(m_tick + Max(ticks, uint64(1)), std::move(fn));
+}
+
+//=============================================================================
+TimerId CTimerWheel::ScheduleAt (Time::Point time, FTimer fn)
+{
+    const sint64 ns     = Max(time.GetRaw(), sint64(0));
+    const uint64 expiry = uint64((ns + m_resolution - 1) / m_resolution);
+    return Insert(Max(expiry, m_tick + 1), std::move(fn));
+}
+
+//=============================================================================
+bool CTimerWheel::Cancel (TimerId id)
+{
+    if (!IsPending(id))
+        return false;
+
+    const uint32 index = uint32(id);
+    Unlink(index);
+    Release(index);
+    return true;
+}
+
+//=============================================================================
+bool CTimerWheel::IsPending (TimerId id) const
+{
+    const uint32 index = uint32(id);
+    if (index >= m_timers.Count())
+        return false;
+
+    const Timer & timer = m_timers[index];
+    return timer.generation == uint32(id >> 32) && timer.slot != SLOT_FREE;
+}
+
+//=============================================================================
+void CTimerWheel::Advance (Time::Point now)
+{
+    ASSERT(now.GetRaw() >= 0);
+    const uint64 target = uint64(now.GetRaw() / m_resolution);
+
+    while (m_tick < target)
+    {
+        // Fire what is due in the rest of the current level 0 turn, jumping
+        // straight between occupied slots. Callbacks may add to later slots,
+        // so look again after each one.
+        const uint64 turn = m_tick & ~uint64(LEVEL_SLOTS - 1);
+        const uint64 last = Min(target, turn + LEVEL_SLOTS - 1);
+
+        uint slot;
+        while ((slot = NextOccupied(0, uint(m_tick - turn) + 1, uint(last - turn))) != LEVEL_SLOTS)
+        {
+            m_tick = turn + slot;
+            Fire(slot);
+        }
+        m_tick = last;
+
+        if (m_tick == target)
+            break;
+
+        // On to the next turn that brings timers down from the levels above,
+        // skipping any in which nothing would move
+        const uint64 next = NextCascade();
+        if (next > target)
+        {
+            m_tick = target;
+            break;
+        }
+
+        m_tick = next;
+        Cascade();
+        Fire(0);
+    }
+}
+
+//=============================================================================
+Time::Point CTimerWheel::Now () const
+{
+    return Time::Point::FromNs(sint64(m_tick) * m_resolution);
+}
+
+//=============================================================================
+TimerId CTimerWheel::Insert (uint64 expiry, FTimer fn)
+{
+    ASSERT(expiry > m_tick);
+
+    uint32 index = m_freeHead;
+    if (index != INDEX_NONE)
+    {
+        m_freeHead = m_timers[index].next;
+    }
+    else
+    {
+        index = m_timers.Count();
+        Timer * timer = m_timers.New();
+        timer->generation = 1;
+    }
+
+    Timer & timer = m_timers[index];
+    timer.fn     = std::move(fn);
+    timer.expiry = expiry;
+    Link(index, SlotFor(expiry));
+
+    ++m_pendingCount;
+    return (TimerId(timer.generation) << 32) | index;
+}
+
+//=============================================================================
+void CTimerWheel::Release (uint32 index)
+{
+    Timer & timer = m_timers[index];
+    timer.fn   = null;
+    timer.slot = SLOT_FREE;
+
+    // Zero is kept out of ids
+    if (!++timer.generation)
+        timer.generation = 1;
+
+    timer.next = m_freeHead;
+    m_freeHead = index;
+
+    --m_pendingCount;
+}
+
+//=============================================================================
+uint CTimerWheel::SlotFor (uint64 expiry) const
+{
+    // The lowest level in whose current turn the expiry falls. Only the
+    // slots ahead of the wheel's position in each level are ever used.
+    const uint64 diff = expiry ^ m_tick;
+    for (uint level = 0; level < LEVEL_COUNT; ++level)
+    {
+        if (!(diff >> (LEVEL_BITS * (level + 1))))
+            return level * LEVEL_SLOTS + uint(expiry >> (LEVEL_BITS * level)) % LEVEL_SLOTS;
+    }
+    return SLOT_OVERFLOW;
+}
+
+//=============================================================================
+void CTimerWheel::Link (uint32 index, uint slot)
+{
+    Timer & timer = m_timers[index];
+    timer.slot = slot;
+    timer.prev = INDEX_NONE;
+    timer.next = m_heads[slot];
+
+    if (timer.next != INDEX_NONE)
+        m_timers[timer.next].prev = index;
+    m_heads[slot] = index;
+
+    if (slot < SLOT_OVERFLOW)
+        m_occupied[slot / LEVEL_SLOTS][slot % LEVEL_SLOTS / 64] |= uint64(1) << (slot % 64);
+}
+
+//=============================================================================
+void CTimerWheel::Unlink (uint32 index)
+{
+    Timer & timer = m_timers[index];
+    const uint slot = timer.slot;
+
+    if (timer.prev != INDEX_NONE)
+        m_timers[timer.prev].next = timer.next;
+    else
+        m_heads[slot] = timer.next;
+
+    if (timer.next != INDEX_NONE)
+        m_timers[timer.next].prev = timer.prev;
+
+    if (slot < SLOT_OVERFLOW && m_heads[slot] == INDEX_NONE)
+        m_occupied[slot / LEVEL_SLOTS][slot % LEVEL_SLOTS / 64] &= ~(uint64(1) << (slot % 64));
+}
+
+//=============================================================================
+uint CTimerWheel::NextOccupied (uint level, uint first, uint last) const
+{
+    // First occupied slot of level in [first, last], or LEVEL_SLOTS if none
+    for (uint slot = first; slot <= last; )
+    {
+        const uint64 word = m_occupied[level][slot / 64] >> (slot % 64);
+        if (word)
+        {
+            slot += Math::LowestBitIndex(word);
+            return slot <= last ? slot : LEVEL_SLOTS;
+        }
+        slot = (slot / 64 + 1) * 64;
+    }
+    return LEVEL_SLOTS;
+}
+
+//=============================================================================
+uint64 CTimerWheel::NextCascade () const
+{
+    // m_tick is at the end of a level 0 turn. The next slot to come down is
+    // the first occupied one ahead of the wheel in the lowest level that has
+    // any; slots in higher levels are all further off.
+    for (uint level = 1; level < LEVEL_COUNT; ++level)
+    {
+        const uint shift = LEVEL_BITS * level;
+        const uint index = uint(m_tick >> shift) % LEVEL_SLOTS;
+        const uint slot  = NextOccupied(level, index + 1, LEVEL_SLOTS - 1);
+        if (slot != LEVEL_SLOTS)
+            return (m_tick >> (shift + LEVEL_BITS) << (shift + LEVEL_BITS)) | (uint64(slot) << shift);
+    }
+
+    // Otherwise the overflow list, when the top level next turns
+    const uint shift = LEVEL_BITS * LEVEL_COUNT;
+    if (m_heads[SLOT_OVERFLOW] != INDEX_NONE)
+        return ((m_tick >> shift) + 1) << shift;
+
+    return ~uint64(0);
+}
+
+//=============================================================================
+void CTimerWheel::Refile (uint slot)
+{
+    uint32 index = m_heads[slot];
+    m_heads[slot] = INDEX_NONE;
+    if (slot < SLOT_OVERFLOW)
+        m_occupied[slot / LEVEL_SLOTS][slot % LEVEL_SLOTS / 64] &= ~(uint64(1) << (slot % 64));
+
+    while (index != INDEX_NONE)
+    {
+        const uint32 next = m_timers[index].next;
+        Link(index, SlotFor(m_timers[index].expiry));
+        index = next;
+    }
+}
+
+//=============================================================================
+void CTimerWheel::Cascade ()
+{
+    // m_tick has just reached the start of a level 0 turn. Each level whose
+    // own turn also wrapped passes the next slot down as well.
+    for (uint level = 1; level < LEVEL_COUNT; ++level)
+    {
+        const uint index = uint(m_tick >> (LEVEL_BITS * level)) % LEVEL_SLOTS;
+        Refile(level * LEVEL_SLOTS + index);
+        if (index)
+            return;
+    }
+
+    Refile(SLOT_OVERFLOW);
+}
+
+//=============================================================================
+void CTimerWheel::Fire (uint slot)
+{
+    // Moved to a list of their own, so that callbacks cancelling timers in
+    // the same slot unlink them from there
+    uint32 index = m_heads[slot];
+    if (index == INDEX_NONE)
+        return;
+
+    m_heads[slot] = INDEX_NONE;
+    m_occupied[0][slot / 64] &= ~(uint64(1) << (slot % 64));
+
+    m_heads[SLOT_FIRING] = index;
+    for ( ; index != INDEX_NONE; index = m_timers[index].next)
+        m_timers[index].slot = SLOT_FIRING;
+
+    while ((index = m_heads[SLOT_FIRING]) != INDEX_NONE)
+    {
+        Unlink(index);
+
+        // Released first, so the callback may reschedule into the same entry
+        FTimer fn = std::move(m_timers[index].fn);
+        Release(index);
+        fn();
+    }
+}
@@ -6,24 +6,29 @@
 //
 // TArray
 //
+// Growable array. The allocator A is a standard allocator, by default one that
+// honours alignof(T); use TAlignedArray for a larger alignment and TFrameArray
+// for temporaries that live no longer than the current frame.
+//
 //*****************************************************************************
 
-template <typename T>
+template <typename T, typename A = TAlignedAllocator<T>>
 class TArray
 {
 public:
     inline TArray ();
-    inline TArray (const TArray<T> & rhs);
-    inline TArray (TArray<T> && rhs);
+    inline TArray (const TArray<T, A> & rhs);
+    inline TArray (TArray<T, A> && rhs);
     inline ~TArray ();
 
-    inline TArray<T> & operator= (TArray<T> && rhs);
+    inline TArray<T, A> & operator= (const TArray<T, A> & rhs);
+    inline TArray<T, A> & operator= (TArray<T, A> && rhs);
 
     inline bool IsEmpty () const;
 
     inline void Add (const T & value);
     inline void Add (T && value);
-    inline void Add (const TArray<T> & arr);
+    inline void Add (const TArray<T, A> & arr);
     inline void Add (const T values[], uint count);
     inline T *  New ();
     inline void RemoveUnordered (uint index);
@@ -52,11 +57,11 @@ public:
 
 public:
 
-    template <typename Y>
-    friend bool operator== (const TArray<Y> & lhs, const TArray<Y> & rhs);
+    template <typename Y, typename B>
+    friend bool operator== (const TArray<Y, B> & lhs, const TArray<Y, B> & rhs);
 
-    template <typename Y>
-    friend bool operator<  (const TArray<Y> & lhs, const TArray<Y> & rhs);
+    template <typename Y, typename B>
+    friend bool operator<  (const TArray<Y, B> & lhs, const TArray<Y, B> & rhs);
 
 public:
 
@@ -67,5 +72,34 @@ public:
     T * end ();
 
 private:
-    std::vector<T> m_array;
-};
\ No newline at end of file
+    std::vector<T, A> m_array;
+};
+
+
+
+//*****************************************************************************
+//
+// TFrameArray
+//
+// TArray allocated from the calling thread's frame arena. Growing costs a
+// pointer bump and freeing is a no-op, but the array must be destroyed before
+// that arena is reset at the end of the frame.
+//
+//*****************************************************************************
+
+template <typename T>
+using TFrameArray = TArray<T, TArenaAllocator<T>>;
+
+
+
+//*****************************************************************************
+//
+// TAlignedArray
+//
+// TArray whose storage is aligned to at least Align bytes, for SoA buffers
+// that SIMD kernels read with aligned loads.
+//
+//*****************************************************************************
+
+template <typename T, uint Align>
+using TAlignedArray = TArray<T, TAlignedAllocator<T, Align>>;
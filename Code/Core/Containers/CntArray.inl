@@ -6,161 +6,169 @@
 //*****************************************************************************
 
 //=============================================================================
-template <typename T>
-TArray<T>::TArray ()
+template <typename T, typename A>
+TArray<T, A>::TArray ()
 {
 
 }
 
- //=============================================================================
-template <typename T>
-TArray<T>::TArray (const TArray<T> & rhs) :
+//=============================================================================
+template <typename T, typename A>
+TArray<T, A>::TArray (const TArray<T, A> & rhs) :
     m_array(rhs.m_array)
 {
 }
 
 //=============================================================================
-template <typename T>
-TArray<T>::TArray (TArray<T> && rhs) :
-    m_array(std::forward<std::vector<T>>(rhs.m_array))
+template <typename T, typename A>
+TArray<T, A>::TArray (TArray<T, A> && rhs) :
+    m_array(std::forward<std::vector<T, A>>(rhs.m_array))
 {
 }
 
 //=============================================================================
-template <typename T>
-TArray<T>::~TArray ()
+template <typename T, typename A>
+TArray<T, A>::~TArray ()
 {
 
 }
 
 //=============================================================================
-template <typename T>
-TArray<T> & TArray<T>::operator= (TArray<T> && rhs)
+template <typename T, typename A>
+TArray<T, A> & TArray<T, A>::operator= (const TArray<T, A> & rhs)
 {
-    m_array = std::forward<std::vector<T>>(rhs.m_array);
+    m_array = rhs.m_array;
     return *this;
 }
 
 //=============================================================================
-template <typename T>
-bool TArray<T>::IsEmpty () const
+template <typename T, typename A>
+TArray<T, A> & TArray<T, A>::operator= (TArray<T, A> && rhs)
+{
+    m_array = std::forward<std::vector<T, A>>(rhs.m_array);
+    return *this;
+}
+
+//=============================================================================
+template <typename T, typename A>
+bool TArray<T, A>::IsEmpty () const
 {
     return m_array.empty();
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::Add (const T & value)
+template <typename T, typename A>
+void TArray<T, A>::Add (const T & value)
 {
     m_array.push_back(value);
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::Add (T && value)
+template <typename T, typename A>
+void TArray<T, A>::Add (T && value)
 {
-    m_array.push_back(value);
+    m_array.push_back(std::move(value));
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::Add (const TArray<T> & arr)
+template <typename T, typename A>
+void TArray<T, A>::Add (const TArray<T, A> & arr)
 {
     m_array.insert(m_array.end(), arr.m_array.begin(), arr.m_array.end());
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::Add (const T values[], uint count)
+template <typename T, typename A>
+void TArray<T, A>::Add (const T values[], uint count)
 {
     m_array.insert(m_array.end(), values, values + count);
 }
 
 //=============================================================================
-template <typename T>
-T * TArray<T>::New ()
+template <typename T, typename A>
+T * TArray<T, A>::New ()
 {
     m_array.push_back(T());
     return &m_array.back();
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::RemoveUnordered (uint index)
+template <typename T, typename A>
+void TArray<T, A>::RemoveUnordered (uint index)
 {
     m_array[index] = m_array[Count() - 1];
     m_array.pop_back();
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::RemoveOrdered (uint index)
+template <typename T, typename A>
+void TArray<T, A>::RemoveOrdered (uint index)
 {
     m_array.erase(m_array.begin() + index);
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::RemoveOrdered (uint first, uint term)
+template <typename T, typename A>
+void TArray<T, A>::RemoveOrdered (uint first, uint term)
 {
     m_array.erase(m_array.begin() + first, m_array.begin() + term);
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::Clear ()
+template <typename T, typename A>
+void TArray<T, A>::Clear ()
 {
     m_array.clear();
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::Reserve (uint count)
+template <typename T, typename A>
+void TArray<T, A>::Reserve (uint count)
 {
     m_array.reserve(count);
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::ReserveAdditional (uint count)
+template <typename T, typename A>
+void TArray<T, A>::ReserveAdditional (uint count)
 {
     m_array.reserve(Count() + count);
 }
 
 //=============================================================================
-template <typename T>
-void TArray<T>::Resize (uint count)
+template <typename T, typename A>
+void TArray<T, A>::Resize (uint count)
 {
     m_array.resize(count);
 }
 
 //=============================================================================
-template <typename T>
-uint TArray<T>::Find (const T & value) const
+template <typename T, typename A>
+uint TArray<T, A>::Find (const T & value) const
 {
     auto it = std::find(m_array.begin(), m_array.end(), value);
     return it - m_array.begin();
 }
 
 //=============================================================================
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-uint TArray<T>::Find (const U & value) const
+uint TArray<T, A>::Find (const U & value) const
 {
     auto it = std::find(m_array.begin(), m_array.end(), value);
     return uint(it - m_array.begin());
 }
 
 //=============================================================================
-template <typename T>
-bool TArray<T>::Contains (const T & value) const
+template <typename T, typename A>
+bool TArray<T, A>::Contains (const T & value) const
 {
     return Find(value) < Count();
 }
 
 //=============================================================================
-template <typename T>
-uint TArray<T>::Index (const T * ptr) const
+template <typename T, typename A>
+uint TArray<T, A>::Index (const T * ptr) const
 {
     const ptrdiff_t index = ptr - Ptr();
     if (Math::IsInRange<ptrdiff_t>(index, 0, Count()))
@@ -169,109 +177,109 @@ uint TArray<T>::Index (const T * ptr) const
 }
 
 //=============================================================================
-template <typename T>
-T * TArray<T>::Ptr ()
+template <typename T, typename A>
+T * TArray<T, A>::Ptr ()
 {
     return m_array.data();
 }
 
 //=============================================================================
-template <typename T>
-const T * TArray<T>::Ptr () const
+template <typename T, typename A>
+const T * TArray<T, A>::Ptr () const
 {
     return m_array.data();
 }
 
 //=============================================================================
-template <typename T>
-T * TArray<T>::Term ()
+template <typename T, typename A>
+T * TArray<T, A>::Term ()
 {
     return Ptr() + Count();
 }
 
 //=============================================================================
-template <typename T>
-const T * TArray<T>::Term () const
+template <typename T, typename A>
+const T * TArray<T, A>::Term () const
 {
     return Ptr() + Count();
 }
 
 //=============================================================================
-template <typename T>
-T * TArray<T>::Top ()
+template <typename T, typename A>
+T * TArray<T, A>::Top ()
 {
     ASSERT(Count() > 0);
     return Ptr() + Count() - 1;
 }
 
 //=============================================================================
-template <typename T>
-const T * TArray<T>::Top () const
+template <typename T, typename A>
+const T * TArray<T, A>::Top () const
 {
     ASSERT(Count() > 0);
     return Ptr() + Count() - 1;
 }
 
 //=============================================================================
-template <typename T>
-uint TArray<T>::Count () const
+template <typename T, typename A>
+uint TArray<T, A>::Count () const
 {
     return uint(m_array.size());
 }
 
 //=============================================================================
-template <typename T>
-const T & TArray<T>::operator[] (uint index) const
+template <typename T, typename A>
+const T & TArray<T, A>::operator[] (uint index) const
 {
     return m_array[index];
 }
 
 //=============================================================================
-template <typename T>
-T & TArray<T>::operator[] (uint index)
+template <typename T, typename A>
+T & TArray<T, A>::operator[] (uint index)
 {
     return m_array[index];
 }
 
 //=============================================================================
-template <typename T>
-const T * TArray<T>::begin () const
+template <typename T, typename A>
+const T * TArray<T, A>::begin () const
 {
     return Ptr();
 }
 
 //=============================================================================
-template <typename T>
-T * TArray<T>::begin ()
+template <typename T, typename A>
+T * TArray<T, A>::begin ()
 {
     return Ptr();
 }
 
 //=============================================================================
-template <typename T>
-const T * TArray<T>::end () const
+template <typename T, typename A>
+const T * TArray<T, A>::end () const
 {
     return Ptr() + Count();
 }
 
 //=============================================================================
-template <typename T>
-T * TArray<T>::end ()
+template <typename T, typename A>
+T * TArray<T, A>::end ()
 {
     return Ptr() + Count();
 }
 
 
 //=============================================================================
-template <typename Y>
-bool operator== (const TArray<Y> & lhs, const TArray<Y> & rhs)
+template <typename Y, typename B>
+bool operator== (const TArray<Y, B> & lhs, const TArray<Y, B> & rhs)
 {
     return lhs.m_array == rhs.m_array;
 }
 
 //=============================================================================
-template <typename Y>
-bool operator< (const TArray<Y> & lhs, const TArray<Y> & rhs)
+template <typename Y, typename B>
+bool operator< (const TArray<Y, B> & lhs, const TArray<Y, B> & rhs)
 {
     return lhs.m_array < rhs.m_array;
 }
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <iterator>
+
+#ifdef SIMD_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace Containers {
+namespace Internal {
+
+//*****************************************************************************
+//
+// Bit word kernels
+//
+// Shared by TBitSet and CBitArray. Bulk operations work on 128 bits at a time
+// when SSE2 is available and fall back to 64 bit words otherwise.
+//
+//*****************************************************************************
+
+inline void BitsAnd (uint64 dst[], const uint64 src[], uint words);
+inline void BitsOr (uint64 dst[], const uint64 src[], uint words);
+inline void BitsXor (uint64 dst[], const uint64 src[], uint words);
+inline void BitsAndNot (uint64 dst[], const uint64 src[], uint words);    // dst &= ~src
+inline bool BitsIntersect (const uint64 a[], const uint64 b[], uint words);
+inline bool BitsIsSubset (const uint64 a[], const uint64 b[], uint words); // a is a subset of b
+inline bool BitsEqual (const uint64 a[], const uint64 b[], uint words);
+inline bool BitsAny (const uint64 words[], uint count);
+inline uint BitsCount (const uint64 words[], uint count);
+inline uint BitsFindFirstSet (const uint64 words[], uint count, uint start);
+
+
+
+//*****************************************************************************
+//
+// CSetBitIterator
+//
+// Forward iterator over the indices of the set bits in a word array.
+//
+//*****************************************************************************
+
+class CSetBitIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef uint                      value_type;
+    typedef ptrdiff_t                 difference_type;
+    typedef const uint *              pointer;
+    typedef uint                      reference;
+
+    inline CSetBitIterator (const uint64 words[], uint count, uint word);
+
+    uint operator* () const { return m_word * 64 + Math::LowestBitIndex(m_bits); }
+    inline CSetBitIterator & operator++ ();
+    CSetBitIterator operator++ (int) { CSetBitIterator it = *this; ++*this; return it; }
+
+    bool operator== (const CSetBitIterator & rhs) const { return m_word == rhs.m_word && m_bits == rhs.m_bits; }
+    bool operator!= (const CSetBitIterator & rhs) const { return !(*this == rhs); }
+
+private:
+    const uint64 * m_words;
+    uint           m_count;
+    uint           m_word;
+    uint64         m_bits;  // Remaining set bits of the current word
+
+    inline void SkipEmpty ();
+};
+
+}} // namespace Containers::Internal
+
+
+
+//*****************************************************************************
+//
+// TBitSet
+//
+// Fixed size set of N bits, for masks that outgrow Flags32 such as component
+// signatures and collision filters.
+//
+//*****************************************************************************
+
+template <uint N>
+class TBitSet
+{
+    static_assert(N > 0, "Bit set must hold at least one bit");
+
+public:
+    static const uint WORD_COUNT = (N + 63) / 64;
+
+    inline TBitSet ();
+
+    inline uint Size () const { return N; }
+    inline uint Count () const;
+    inline bool Any () const;
+    inline bool None () const;
+
+    inline bool Get (uint index) const;
+    inline void Set (uint index);
+    inline void Set (uint index, bool value);
+    inline void Clear (uint index);
+    inline void Toggle (uint index);
+    inline void SetAll ();
+    inline void ClearAll ();
+
+    inline uint FindFirstSet (uint start = 0) const;    // (uint)-1 if none
+
+    inline bool Intersects (const TBitSet<N> & rhs) const;
+    inline bool IsSubsetOf (const TBitSet<N> & rhs) const;
+
+    inline TBitSet<N> & operator&= (const TBitSet<N> & rhs);
+    inline TBitSet<N> & operator|= (const TBitSet<N> & rhs);
+    inline TBitSet<N> & operator^= (const TBitSet<N> & rhs);
+    inline TBitSet<N> & AndNot (const TBitSet<N> & rhs);
+
+    inline bool operator== (const TBitSet<N> & rhs) const;
+    inline bool operator!= (const TBitSet<N> & rhs) const;
+
+    inline const uint64 * Words () const { return m_words; }
+
+public: // Iteration over the indices of set bits
+
+    typedef Containers::Internal::CSetBitIterator CIterator;
+
+    inline CIterator begin () const;
+    inline CIterator end () const;
+
+private:
+    alignas(16) uint64 m_words[WORD_COUNT];
+};
+
+template <uint N> inline TBitSet<N> operator& (TBitSet<N> lhs, const TBitSet<N> & rhs);
+template <uint N> inline TBitSet<N> operator| (TBitSet<N> lhs, const TBitSet<N> & rhs);
+template <uint N> inline TBitSet<N> operator^ (TBitSet<N> lhs, const TBitSet<N> & rhs);
+
+
+
+//*****************************************************************************
+//
+// CBitArray
+//
+// Dynamically sized bit array, e.g. visited flags indexed by node. Bulk
+// operations require both operands to have the same size.
+//
+//*****************************************************************************
+
+class CBitArray
+{
+public:
+    inline CBitArray ();
+    inline explicit CBitArray (uint size);
+
+    inline uint Size () const { return m_size; }
+    inline uint Count () const;
+    inline bool Any () const;
+    inline bool None () const;
+
+    inline void Resize (uint size);     // New bits are clear
+    inline void Clear ();               // Size becomes zero
+
+    inline bool Get (uint index) const;
+    inline void Set (uint index);
+    inline void Set (uint index, bool value);
+    inline void Clear (uint index);
+    inline void Toggle (uint index);
+    inline void SetAll ();
+    inline void ClearAll ();
+
+    inline uint FindFirstSet (uint start = 0) const;    // (uint)-1 if none
+
+    inline bool Intersects (const CBitArray & rhs) const;
+    inline bool IsSubsetOf (const CBitArray & rhs) const;
+
+    inline CBitArray & operator&= (const CBitArray & rhs);
+    inline CBitArray & operator|= (const CBitArray & rhs);
+    inline CBitArray & operator^= (const CBitArray & rhs);
+    inline CBitArray & AndNot (const CBitArray & rhs);
+
+    inline bool operator== (const CBitArray & rhs) const;
+    inline bool operator!= (const CBitArray & rhs) const;
+
+    inline const uint64 * Words () const { return m_words.Ptr(); }
+
+public: // Iteration over the indices of set bits
+
+    typedef Containers::Internal::CSetBitIterator CIterator;
+
+    inline CIterator begin () const;
+    inline CIterator end () const;
+
+private:
+    TArray<uint64> m_words;
+    uint           m_size;
+
+    inline void ClearUnusedBits ();
+};
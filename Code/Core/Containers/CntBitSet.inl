@@ -0,0 +1,654 @@
+namespace Containers {
+namespace Internal {
+
+//*****************************************************************************
+//
+// Bit word kernels
+//
+//*****************************************************************************
+
+#ifdef SIMD_SSE2
+
+#define BITS_BINARY_OP(name, sseExpr, scalarExpr)                                   \
+    void name (uint64 dst[], const uint64 src[], uint words)                        \
+    {                                                                               \
+        uint i = 0;                                                                 \
+        for (; i + 2 <= words; i += 2)                                              \
+        {                                                                           \
+            const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));          \
+            const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));          \
+            _mm_storeu_si128((__m128i *)(dst + i), sseExpr);                        \
+        }                                                                           \
+        for (; i < words; ++i)                                                      \
+            dst[i] = scalarExpr;                                                    \
+    }
+
+BITS_BINARY_OP(BitsAnd,    _mm_and_si128(d, s),    dst[i] & src[i])
+BITS_BINARY_OP(BitsOr,     _mm_or_si128(d, s),     dst[i] | src[i])
+BITS_BINARY_OP(BitsXor,    _mm_xor_si128(d, s),    dst[i] ^ src[i])
+BITS_BINARY_OP(BitsAndNot, _mm_andnot_si128(s, d), dst[i] & ~src[i])
+
+#undef BITS_BINARY_OP
+
+//=============================================================================
+inline bool IsZero (__m128i v)
+{
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xffff;
+}
+
+//=============================================================================
+bool BitsIntersect (const uint64 a[], const uint64 b[], uint words)
+{
+    // Accumulate and test once per loop rather than branching on every lane
+    uint i = 0;
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= words; i += 2)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        const __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+        acc = _mm_or_si128(acc, _mm_and_si128(x, y));
+    }
+
+    uint64 tail = 0;
+    for (; i < words; ++i)
+        tail |= a[i] & b[i];
+
+    return tail || !IsZero(acc);
+}
+
+//=============================================================================
+bool BitsIsSubset (const uint64 a[], const uint64 b[], uint words)
+{
+    uint i = 0;
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= words; i += 2)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        const __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+        acc = _mm_or_si128(acc, _mm_andnot_si128(y, x));
+    }
+
+    uint64 tail = 0;
+    for (; i < words; ++i)
+        tail |= a[i] & ~b[i];
+
+    return !tail && IsZero(acc);
+}
+
+//=============================================================================
+bool BitsEqual (const uint64 a[], const uint64 b[], uint words)
+{
+    uint i = 0;
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= words; i += 2)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        const __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+        acc = _mm_or_si128(acc, _mm_xor_si128(x, y));
+    }
+
+    uint64 tail = 0;
+    for (; i < words; ++i)
+        tail |= a[i] ^ b[i];
+
+    return !tail && IsZero(acc);
+}
+
+//=============================================================================
+bool BitsAny (const uint64 words[], uint count)
+{
+    uint i = 0;
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2)
+        acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i *)(words + i)));
+
+    uint64 tail = 0;
+    for (; i < count; ++i)
+        tail |= words[i];
+
+    return tail || !IsZero(acc);
+}
+
+#else // SIMD_SSE2
+
+//=============================================================================
+void BitsAnd (uint64 dst[], const uint64 src[], uint words)
+{
+    for (uint i = 0; i < words; ++i)
+        dst[i] &= src[i];
+}
+
+//=============================================================================
+void BitsOr (uint64 dst[], const uint64 src[], uint words)
+{
+    for (uint i = 0; i < words; ++i)
+        dst[i] |= src[i];
+}
+
+//=============================================================================
+void BitsXor (uint64 dst[], const uint64 src[], uint words)
+{
+    for (uint i = 0; i < words; ++i)
+        dst[i] ^= src[i];
+}
+
+//=============================================================================
+void BitsAndNot (uint64 dst[], const uint64 src[], uint words)
+{
+    for (uint i = 0; i < words; ++i)
+        dst[i] &= ~src[i];
+}
+
+//=============================================================================
+bool BitsIntersect (const uint64 a[], const uint64 b[], uint words)
+{
+    uint64 acc = 0;
+    for (uint i = 0; i < words; ++i)
+        acc |= a[i] & b[i];
+    return acc != 0;
+}
+
+//=============================================================================
+bool BitsIsSubset (const uint64 a[], const uint64 b[], uint words)
+{
+    uint64 acc = 0;
+    for (uint i = 0; i < words; ++i)
+        acc |= a[i] & ~b[i];
+    return acc == 0;
+}
+
+//=============================================================================
+bool BitsEqual (const uint64 a[], const uint64 b[], uint words)
+{
+    uint64 acc = 0;
+    for (uint i = 0; i < words; ++i)
+        acc |= a[i] ^ b[i];
+    return acc == 0;
+}
+
+//=============================================================================
+bool BitsAny (const uint64 words[], uint count)
+{
+    uint64 acc = 0;
+    for (uint i = 0; i < count; ++i)
+        acc |= words[i];
+    return acc != 0;
+}
+
+#endif // SIMD_SSE2
+
+//=============================================================================
+uint BitsCount (const uint64 words[], uint count)
+{
+    // Independent accumulators let the popcounts overlap
+    uint a = 0;
+    uint b = 0;
+    uint i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        a += Math::BitCount(words[i]);
+        b += Math::BitCount(words[i + 1]);
+    }
+    if (i < count)
+        a += Math::BitCount(words[i]);
+
+    return a + b;
+}
+
+//=============================================================================
+uint BitsFindFirstSet (const uint64 words[], uint count, uint start)
+{
+    uint word = start / 64;
+    if (word >= count)
+        return (uint)-1;
+
+    // Mask off the bits below start in the first word
+    uint64 bits = words[word] & (~uint64(0) << (start % 64));
+    while (!bits)
+    {
+        if (++word >= count)
+            return (uint)-1;
+        bits = words[word];
+    }
+
+    return word * 64 + Math::LowestBitIndex(bits);
+}
+
+
+
+//*****************************************************************************
+//
+// CSetBitIterator
+//
+//*****************************************************************************
+
+//=============================================================================
+CSetBitIterator::CSetBitIterator (const uint64 words[], uint count, uint word) :
+    m_words(words),
+    m_count(count),
+    m_word(word),
+    m_bits(word < count ? words[word] : 0)
+{
+    SkipEmpty();
+}
+
+//=============================================================================
+CSetBitIterator & CSetBitIterator::operator++ ()
+{
+    // Clear the lowest set bit
+    m_bits &= m_bits - 1;
+    SkipEmpty();
+    return *this;
+}
+
+//=============================================================================
+void CSetBitIterator::SkipEmpty ()
+{
+    while (!m_bits && m_word < m_count)
+    {
+        if (++m_word < m_count)
+            m_bits = m_words[m_word];
+    }
+}
+
+}} // namespace Containers::Internal
+
+
+
+//*****************************************************************************
+//
+// TBitSet
+//
+//*****************************************************************************
+
+//=============================================================================
+template <uint N>
+TBitSet<N>::TBitSet ()
+{
+    ClearAll();
+}
+
+//=============================================================================
+template <uint N>
+uint TBitSet<N>::Count () const
+{
+    return Containers::Internal::BitsCount(m_words, WORD_COUNT);
+}
+
+//=============================================================================
+template <uint N>
+bool TBitSet<N>::Any () const
+{
+    return Containers::Internal::BitsAny(m_words, WORD_COUNT);
+}
+
+//=============================================================================
+template <uint N>
+bool TBitSet<N>::None () const
+{
+    return !Any();
+}
+
+//=============================================================================
+template <uint N>
+bool TBitSet<N>::Get (uint index) const
+{
+    ASSERT(index < N);
+    return (m_words[index / 64] >> (index % 64)) & 1;
+}
+
+//=============================================================================
+template <uint N>
+void TBitSet<N>::Set (uint index)
+{
+    ASSERT(index < N);
+    m_words[index / 64] |= uint64(1) << (index % 64);
+}
+
+//=============================================================================
+template <uint N>
+void TBitSet<N>::Set (uint index, bool value)
+{
+    if (value)
+        Set(index);
+    else
+        Clear(index);
+}
+
+//=============================================================================
+template <uint N>
+void TBitSet<N>::Clear (uint index)
+{
+    ASSERT(index < N);
+    m_words[index / 64] &= ~(uint64(1) << (index % 64));
+}
+
+//=============================================================================
+template <uint N>
+void TBitSet<N>::Toggle (uint index)
+{
+    ASSERT(index < N);
+    m_words[index / 64] ^= uint64(1) << (index % 64);
+}
+
+//=============================================================================
+template <uint N>
+void TBitSet<N>::SetAll ()
+{
+    for (uint64 & word : m_words)
+        word = ~uint64(0);
+
+    // Bits past N must stay clear so Count and comparisons stay exact
+    if (N % 64)
+        m_words[WORD_COUNT - 1] = (uint64(1) << (N % 64)) - 1;
+}
+
+//=============================================================================
+template <uint N>
+void TBitSet<N>::ClearAll ()
+{
+    for (uint64 & word : m_words)
+        word = 0;
+}
+
+//=============================================================================
+template <uint N>
+uint TBitSet<N>::FindFirstSet (uint start) const
+{
+    return Containers::Internal::BitsFindFirstSet(m_words, WORD_COUNT, start);
+}
+
+//=============================================================================
+template <uint N>
+bool TBitSet<N>::Intersects (const TBitSet<N> & rhs) const
+{
+    return Containers::Internal::BitsIntersect(m_words, rhs.m_words, WORD_COUNT);
+}
+
+//=============================================================================
+template <uint N>
+bool TBitSet<N>::IsSubsetOf (const TBitSet<N> & rhs) const
+{
+    return Containers::Internal::BitsIsSubset(m_words, rhs.m_words, WORD_COUNT);
+}
+
+//=============================================================================
+template <uint N>
+TBitSet<N> & TBitSet<N>::operator&= (const TBitSet<N> & rhs)
+{
+    Containers::Internal::BitsAnd(m_words, rhs.m_words, WORD_COUNT);
+    return *this;
+}
+
+//=============================================================================
+template <uint N>
+TBitSet<N> & TBitSet<N>::operator|= (const TBitSet<N> & rhs)
+{
+    Containers::Internal::BitsOr(m_words, rhs.m_words, WORD_COUNT);
+    return *this;
+}
+
+//=============================================================================
+template <uint N>
+TBitSet<N> & TBitSet<N>::operator^= (const TBitSet<N> & rhs)
+{
+    Containers::Internal::BitsXor(m_words, rhs.m_words, WORD_COUNT);
+    return *this;
+}
+
+//=============================================================================
+template <uint N>
+TBitSet<N> & TBitSet<N>::AndNot (const TBitSet<N> & rhs)
+{
+    Containers::Internal::BitsAndNot(m_words, rhs.m_words, WORD_COUNT);
+    return *this;
+}
+
+//=============================================================================
+template <uint N>
+bool TBitSet<N>::operator== (const TBitSet<N> & rhs) const
+{
+    return Containers::Internal::BitsEqual(m_words, rhs.m_words, WORD_COUNT);
+}
+
+//=============================================================================
+template <uint N>
+bool TBitSet<N>::operator!= (const TBitSet<N> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//=============================================================================
+template <uint N>
+typename TBitSet<N>::CIterator TBitSet<N>::begin () const
+{
+    return CIterator(m_words, WORD_COUNT, 0);
+}
+
+//=============================================================================
+template <uint N>
+typename TBitSet<N>::CIterator TBitSet<N>::end () const
+{
+    return CIterator(m_words, WORD_COUNT, WORD_COUNT);
+}
+
+//=============================================================================
+template <uint N>
+TBitSet<N> operator& (TBitSet<N> lhs, const TBitSet<N> & rhs)
+{
+    return lhs &= rhs;
+}
+
+//=============================================================================
+template <uint N>
+TBitSet<N> operator| (TBitSet<N> lhs, const TBitSet<N> & rhs)
+{
+    return lhs |= rhs;
+}
+
+//=============================================================================
+template <uint N>
+TBitSet<N> operator^ (TBitSet<N> lhs, const TBitSet<N> & rhs)
+{
+    return lhs ^= rhs;
+}
+
+
+
+//*****************************************************************************
+//
+// CBitArray
+//
+//*****************************************************************************
+
+//=============================================================================
+CBitArray::CBitArray () :
+    m_size(0)
+{
+}
+
+//=============================================================================
+CBitArray::CBitArray (uint size) :
+    m_size(0)
+{
+    Resize(size);
+}
+
+//=============================================================================
+uint CBitArray::Count () const
+{
+    return Containers::Internal::BitsCount(m_words.Ptr(), m_words.Count());
+}
+
+//=============================================================================
+bool CBitArray::Any () const
+{
+    return Containers::Internal::BitsAny(m_words.Ptr(), m_words.Count());
+}
+
+//=============================================================================
+bool CBitArray::None () const
+{
+    return !Any();
+}
+
+//=============================================================================
+void CBitArray::Resize (uint size)
+{
+    const uint oldWords = m_words.Count();
+    const uint newWords = (size + 63) / 64;
+
+    // Clear the tail of the current last word before it is exposed
+    const uint oldSize = m_size;
+    m_size = Min(oldSize, size);
+    ClearUnusedBits();
+
+    m_words.Resize(newWords);
+    for (uint i = oldWords; i < newWords; ++i)
+        m_words[i] = 0;
+
+    m_size = size;
+    ClearUnusedBits();
+}
+
+//=============================================================================
+void CBitArray::Clear ()
+{
+    m_words.Clear();
+    m_size = 0;
+}
+
+//=============================================================================
+bool CBitArray::Get (uint index) const
+{
+    ASSERT(index < m_size);
+    return (m_words[index / 64] >> (index % 64)) & 1;
+}
+
+//=============================================================================
+void CBitArray::Set (uint index)
+{
+    ASSERT(index < m_size);
+    m_words[index / 64] |= uint64(1) << (index % 64);
+}
+
+//=============================================================================
+void CBitArray::Set (uint index, bool value)
+{
+    if (value)
+        Set(index);
+    else
+        Clear(index);
+}
+
+//=============================================================================
+void CBitArray::Clear (uint index)
+{
+    ASSERT(index < m_size);
+    m_words[index / 64] &= ~(uint64(1) << (index % 64));
+}
+
+//=============================================================================
+void CBitArray::Toggle (uint index)
+{
+    ASSERT(index < m_size);
+    m_words[index / 64] ^= uint64(1) << (index % 64);
+}
+
+//=============================================================================
+void CBitArray::SetAll ()
+{
+    for (uint64 & word : m_words)
+        word = ~uint64(0);
+    ClearUnusedBits();
+}
+
+//=============================================================================
+void CBitArray::ClearAll ()
+{
+    for (uint64 & word : m_words)
+        word = 0;
+}
+
+//=============================================================================
+uint CBitArray::FindFirstSet (uint start) const
+{
+    return Containers::Internal::BitsFindFirstSet(m_words.Ptr(), m_words.Count(), start);
+}
+
+//=============================================================================
+bool CBitArray::Intersects (const CBitArray & rhs) const
+{
+    ASSERT(m_size == rhs.m_size);
+    return Containers::Internal::BitsIntersect(m_words.Ptr(), rhs.m_words.Ptr(), m_words.Count());
+}
+
+//=============================================================================
+bool CBitArray::IsSubsetOf (const CBitArray & rhs) const
+{
+    ASSERT(m_size == rhs.m_size);
+    return Containers::Internal::BitsIsSubset(m_words.Ptr(), rhs.m_words.Ptr(), m_words.Count());
+}
+
+//=============================================================================
+CBitArray & CBitArray::operator&= (const CBitArray & rhs)
+{
+    ASSERT(m_size == rhs.m_size);
+    Containers::Internal::BitsAnd(m_words.Ptr(), rhs.m_words.Ptr(), m_words.Count());
+    return *this;
+}
+
+//=============================================================================
+CBitArray & CBitArray::operator|= (const CBitArray & rhs)
+{
+    ASSERT(m_size == rhs.m_size);
+    Containers::Internal::BitsOr(m_words.Ptr(), rhs.m_words.Ptr(), m_words.Count());
+    return *this;
+}
+
+//=============================================================================
+CBitArray & CBitArray::operator^= (const CBitArray & rhs)
+{
+    ASSERT(m_size == rhs.m_size);
+    Containers::Internal::BitsXor(m_words.Ptr(), rhs.m_words.Ptr(), m_words.Count());
+    return *this;
+}
+
+//=============================================================================
+CBitArray & CBitArray::AndNot (const CBitArray & rhs)
+{
+    ASSERT(m_size == rhs.m_size);
+    Containers::Internal::BitsAndNot(m_words.Ptr(), rhs.m_words.Ptr(), m_words.Count());
+    return *this;
+}
+
+//=============================================================================
+bool CBitArray::operator== (const CBitArray & rhs) const
+{
+    return m_size == rhs.m_size && Containers::Internal::BitsEqual(m_words.Ptr(), rhs.m_words.Ptr(), m_words.Count());
+}
+
+//=============================================================================
+bool CBitArray::operator!= (const CBitArray & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//=============================================================================
+CBitArray::CIterator CBitArray::begin () const
+{
+    return CIterator(m_words.Ptr(), m_words.Count(), 0);
+}
+
+//=============================================================================
+CBitArray::CIterator CBitArray::end () const
+{
+    return CIterator(m_words.Ptr(), m_words.Count(), m_words.Count());
+}
+
+//=============================================================================
+void CBitArray::ClearUnusedBits ()
+{
+    if (m_size % 64 && m_size / 64 < m_words.Count())
+        m_words[m_size / 64] &= (uint64(1) << (m_size % 64)) - 1;
+}
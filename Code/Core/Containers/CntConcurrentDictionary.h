@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+template <typename T>
+struct THash;
+
+//*****************************************************************************
+//
+// TConcurrentDictionary
+//
+// Hash table for lookup tables shared between threads that are read far more
+// often than they are written. Keys are spread over SHARD_COUNT shards by the
+// top bits of their hash, and each shard is an open addressed table guarded
+// by a sequence lock:
+//
+//  - Find and Contains never take a lock or write shared memory, so readers
+//    do not slow each other down. They read the shard's sequence number,
+//    probe, and retry if a writer touched the shard meanwhile.
+//  - Set and Delete take a per-shard spin lock, so writers only contend when
+//    they hash to the same shard.
+//
+// Reads are not lock-free: a reader that finds a write in progress on its
+// shard yields until the write ends, so a writer descheduled mid-write holds
+// up readers of that shard. Writes are short, except when they grow the
+// table, which copies every entry in the shard.
+//
+// Because readers may observe a slot mid-write before retrying, keys and
+// values must be trivially copyable (ids, tokens, pointers, handles).
+//
+// Tables replaced by growth cannot be freed while a reader might still be
+// probing them, so they are retired and only released by Reclaim or the
+// destructor, which must not run concurrently with any other access.
+//
+//*****************************************************************************
+
+template <typename K, typename V, typename H = THash<K>>
+class TConcurrentDictionary
+{
+public:
+    TConcurrentDictionary ();
+    ~TConcurrentDictionary ();
+
+    uint Count () const;
+
+    bool Contains (const K & key) const;
+    bool Find (const K & key, V * value) const;
+    V    Find (const K & key, const V & defaultValue) const;
+
+    void Set (const K & key, const V & value);
+    bool Delete (const K & key);
+    void Clear ();
+
+    // Frees tables retired by growth. No other thread may access the
+    // dictionary while this runs.
+    void Reclaim ();
+
+    // Visits each entry with its shard locked. func must not call back into
+    // the dictionary.
+    template <typename F>
+    void ForEach (F func) const;
+
+private:
+    CLASS_NO_COPY(TConcurrentDictionary);
+
+    static_assert(std::is_trivially_copyable<K>::value, "Keys must be trivially copyable");
+    static_assert(std::is_trivially_copyable<V>::value, "Values must be trivially copyable");
+
+    static const uint SHARD_BITS     = 4;
+    static const uint SHARD_COUNT    = 1 << SHARD_BITS;
+    static const uint MIN_CAPACITY   = 16;
+    static const uint32 HASH_EMPTY   = 0;
+    static const uint32 HASH_DELETED = 1;
+
+    struct Slot
+    {
+        uint32 hash;    // HASH_EMPTY, HASH_DELETED or the key's adjusted hash
+        K      key;
+        V      value;
+    };
+
+    struct Table
+    {
+        uint   mask;
+        uint   used;    // Live plus deleted slots
+        Slot * slots;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Shard
+    {
+        std::atomic<uint>    sequence;  // Odd while a writer is active
+        std::atomic<bool>    locked;
+        std::atomic<Table *> table;
+        std::atomic<uint>    count;
+        TArray<Table *>      retired;
+    };
+
+    mutable Shard m_shards[SHARD_COUNT];
+    H             m_hash;
+
+    uint32 HashKey (const K & key) const;
+    Shard & ShardFor (uint32 hash) const;
+
+    void LockShard (Shard & shard) const;
+    void UnlockShard (Shard & shard) const;
+    void BeginWrite (Shard & shard) const;
+    void EndWrite (Shard & shard) const;
+
+    static Table * NewTable (uint capacity);
+    static void    DeleteTable (Table * table);
+    static Slot *  Probe (const Table * table, uint32 hash, const K & key);
+    static void    Insert (Table * table, uint32 hash, const K & key, const V & value);
+    void           Grow (Shard & shard);
+};
@@ -0,0 +1,352 @@
+//*****************************************************************************
+//
+// TConcurrentDictionary
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename K, typename V, typename H>
+TConcurrentDictionary<K, V, H>::TConcurrentDictionary ()
+{
+    for (Shard & shard : m_shards)
+    {
+        shard.sequence.store(0, std::memory_order_relaxed);
+        shard.locked.store(false, std::memory_order_relaxed);
+        shard.table.store(null, std::memory_order_relaxed);
+        shard.count.store(0, std::memory_order_relaxed);
+    }
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+TConcurrentDictionary<K, V, H>::~TConcurrentDictionary ()
+{
+    Reclaim();
+
+    for (Shard & shard : m_shards)
+        DeleteTable(shard.table.load(std::memory_order_relaxed));
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+uint TConcurrentDictionary<K, V, H>::Count () const
+{
+    uint count = 0;
+    for (const Shard & shard : m_shards)
+        count += shard.count.load(std::memory_order_relaxed);
+    return count;
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+bool TConcurrentDictionary<K, V, H>::Contains (const K & key) const
+{
+    V value;
+    return Find(key, &value);
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+bool TConcurrentDictionary<K, V, H>::Find (const K & key, V * value) const
+{
+    ASSERT(value);
+
+    const uint32 hash = HashKey(key);
+    const Shard & shard = ShardFor(hash);
+
+    for (;;)
+    {
+        const uint begin = shard.sequence.load(std::memory_order_acquire);
+        if (begin & 1)
+        {
+            // A write is in progress and nothing read now could be used
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Copy out before validating, the slot may be overwritten at any time
+        bool found = false;
+        V    result;
+        if (const Table * table = shard.table.load(std::memory_order_acquire))
+        {
+            if (const Slot * slot = Probe(table, hash, key))
+            {
+                result = slot->value;
+                found  = true;
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (shard.sequence.load(std::memory_order_relaxed) == begin)
+        {
+            if (found)
+                *value = result;
+            return found;
+        }
+    }
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+V TConcurrentDictionary<K, V, H>::Find (const K & key, const V & defaultValue) const
+{
+    V value;
+    return Find(key, &value) ? value : defaultValue;
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::Set (const K & key, const V & value)
+{
+    const uint32 hash = HashKey(key);
+    Shard & shard = ShardFor(hash);
+
+    LockShard(shard);
+
+    Table * table = shard.table.load(std::memory_order_relaxed);
+    if (Slot * slot = table ? Probe(table, hash, key) : null)
+    {
+        BeginWrite(shard);
+        slot->value = value;
+        EndWrite(shard);
+    }
+    else
+    {
+        // Keep the load factor, including deleted slots, under 3/4
+        if (!table || (table->used + 1) * 4 > (table->mask + 1) * 3)
+        {
+            Grow(shard);
+            table = shard.table.load(std::memory_order_relaxed);
+        }
+
+        BeginWrite(shard);
+        Insert(table, hash, key, value);
+        EndWrite(shard);
+
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    UnlockShard(shard);
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+bool TConcurrentDictionary<K, V, H>::Delete (const K & key)
+{
+    const uint32 hash = HashKey(key);
+    Shard & shard = ShardFor(hash);
+
+    LockShard(shard);
+
+    Table * table = shard.table.load(std::memory_order_relaxed);
+    Slot * slot = table ? Probe(table, hash, key) : null;
+    if (slot)
+    {
+        // Leave a tombstone so probes for keys placed after it still succeed
+        BeginWrite(shard);
+        slot->hash = HASH_DELETED;
+        EndWrite(shard);
+
+        shard.count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    UnlockShard(shard);
+    return slot != null;
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::Clear ()
+{
+    for (Shard & shard : m_shards)
+    {
+        LockShard(shard);
+
+        if (Table * table = shard.table.load(std::memory_order_relaxed))
+        {
+            BeginWrite(shard);
+            for (uint i = 0; i <= table->mask; ++i)
+                table->slots[i].hash = HASH_EMPTY;
+            table->used = 0;
+            EndWrite(shard);
+        }
+        shard.count.store(0, std::memory_order_relaxed);
+
+        UnlockShard(shard);
+    }
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::Reclaim ()
+{
+    for (Shard & shard : m_shards)
+    {
+        for (Table * table : shard.retired)
+            DeleteTable(table);
+        shard.retired.Clear();
+    }
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+template <typename F>
+void TConcurrentDictionary<K, V, H>::ForEach (F func) const
+{
+    for (Shard & shard : m_shards)
+    {
+        LockShard(shard);
+
+        if (const Table * table = shard.table.load(std::memory_order_relaxed))
+        {
+            for (uint i = 0; i <= table->mask; ++i)
+            {
+                const Slot & slot = table->slots[i];
+                if (slot.hash > HASH_DELETED)
+                    func(slot.key, slot.value);
+            }
+        }
+
+        UnlockShard(shard);
+    }
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+uint32 TConcurrentDictionary<K, V, H>::HashKey (const K & key) const
+{
+    // Keep the reserved slot markers out of the hash range
+    const uint32 hash = m_hash(key);
+    return hash > HASH_DELETED ? hash : hash + 2;
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+typename TConcurrentDictionary<K, V, H>::Shard & TConcurrentDictionary<K, V, H>::ShardFor (uint32 hash) const
+{
+    // Shards use the top bits and slots the bottom bits of the hash
+    return m_shards[hash >> (32 - SHARD_BITS)];
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::LockShard (Shard & shard) const
+{
+    while (shard.locked.exchange(true, std::memory_order_acquire))
+    {
+        while (shard.locked.load(std::memory_order_relaxed))
+            std::this_thread::yield();
+    }
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::UnlockShard (Shard & shard) const
+{
+    shard.locked.store(false, std::memory_order_release);
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::BeginWrite (Shard & shard) const
+{
+    shard.sequence.store(shard.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::EndWrite (Shard & shard) const
+{
+    shard.sequence.store(shard.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+typename TConcurrentDictionary<K, V, H>::Table * TConcurrentDictionary<K, V, H>::NewTable (uint capacity)
+{
+    ASSERT(Math::IsPowerTwo(capacity));
+
+    Table * table = new Table;
+    table->mask   = capacity - 1;
+    table->used   = 0;
+    table->slots  = (Slot *)MemAllocAligned(sizeof(Slot) * capacity, alignof(Slot));
+
+    for (uint i = 0; i < capacity; ++i)
+        table->slots[i].hash = HASH_EMPTY;
+
+    return table;
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::DeleteTable (Table * table)
+{
+    if (!table)
+        return;
+
+    MemFreeAligned(table->slots, alignof(Slot));
+    delete table;
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+typename TConcurrentDictionary<K, V, H>::Slot * TConcurrentDictionary<K, V, H>::Probe (
+    const Table * table,
+    uint32        hash,
+    const K &     key
+) {
+    // Bounded by the table size so a torn read cannot loop forever
+    for (uint i = 0, index = hash & table->mask; i <= table->mask; ++i, index = (index + 1) & table->mask)
+    {
+        Slot * slot = &table->slots[index];
+        if (slot->hash == HASH_EMPTY)
+            return null;
+        if (slot->hash == hash && slot->key == key)
+            return slot;
+    }
+    return null;
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::Insert (Table * table, uint32 hash, const K & key, const V & value)
+{
+    uint index = hash & table->mask;
+    while (table->slots[index].hash > HASH_DELETED)
+        index = (index + 1) & table->mask;
+
+    Slot & slot = table->slots[index];
+    if (slot.hash == HASH_EMPTY)
+        table->used++;
+
+    slot.key   = key;
+    slot.value = value;
+    slot.hash  = hash;
+}
+
+//=============================================================================
+template <typename K, typename V, typename H>
+void TConcurrentDictionary<K, V, H>::Grow (Shard & shard)
+{
+    Table * oldTable = shard.table.load(std::memory_order_relaxed);
+
+    // Size for the live entries only, rehashing drops the tombstones
+    const uint live     = shard.count.load(std::memory_order_relaxed);
+    const uint capacity = Math::NextPowerTwo(Max((live + 1) * 2, (uint)MIN_CAPACITY));
+    Table * newTable    = NewTable(capacity);
+
+    if (oldTable)
+    {
+        for (uint i = 0; i <= oldTable->mask; ++i)
+        {
+            const Slot & slot = oldTable->slots[i];
+            if (slot.hash > HASH_DELETED)
+                Insert(newTable, slot.hash, slot.key, slot.value);
+        }
+        shard.retired.Add(oldTable);
+    }
+
+    // The new table is complete before it is published
+    shard.table.store(newTable, std::memory_order_release);
+}
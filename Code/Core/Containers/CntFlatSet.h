@@ -0,0 +1,46 @@
+#pragma once
+
+//*****************************************************************************
+//
+// TFlatSet
+//
+// Set stored as a sorted contiguous array. Lookups are a binary search over
+// cache friendly memory and iteration is a linear walk in sorted order, but
+// Add and Remove shift elements. Prefer it over TSet for small sets that are
+// read far more often than they are modified.
+//
+//*****************************************************************************
+
+template <typename T, typename C = std::less<T>>
+class TFlatSet
+{
+public:
+    TFlatSet ();
+    ~TFlatSet ();
+
+    uint Count () const;
+    bool IsEmpty () const;
+
+    void Clear ();
+    void Reserve (uint count);
+    bool Contains (const T & key) const;
+    uint Find (const T & key) const;
+
+    bool Add (const T & value);
+    bool Add (T && value);
+    bool Remove (const T & key);
+
+    const T * Ptr () const;
+    const T & operator[] (uint index) const;
+
+public:
+
+    const T * begin () const;
+    const T * end () const;
+
+private:
+    TArray<T> m_array;
+    C         m_comp;
+
+    uint LowerBound (const T & key) const;
+};
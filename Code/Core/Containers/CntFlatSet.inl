@@ -0,0 +1,131 @@
+//*****************************************************************************
+//
+// TFlatSet
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, typename C>
+TFlatSet<T,C>::TFlatSet ()
+{
+}
+
+//=============================================================================
+template <typename T, typename C>
+TFlatSet<T,C>::~TFlatSet ()
+{
+}
+
+//=============================================================================
+template <typename T, typename C>
+uint TFlatSet<T,C>::Count () const
+{
+    return m_array.Count();
+}
+
+//=============================================================================
+template <typename T, typename C>
+bool TFlatSet<T,C>::IsEmpty () const
+{
+    return m_array.IsEmpty();
+}
+
+//=============================================================================
+template <typename T, typename C>
+void TFlatSet<T,C>::Clear ()
+{
+    m_array.Clear();
+}
+
+//=============================================================================
+template <typename T, typename C>
+void TFlatSet<T,C>::Reserve (uint count)
+{
+    m_array.Reserve(count);
+}
+
+//=============================================================================
+template <typename T, typename C>
+bool TFlatSet<T,C>::Contains (const T & key) const
+{
+    return Find(key) < Count();
+}
+
+//=============================================================================
+template <typename T, typename C>
+uint TFlatSet<T,C>::Find (const T & key) const
+{
+    const uint index = LowerBound(key);
+    if (index < Count() && !m_comp(key, m_array[index]))
+        return index;
+    return (uint)-1;
+}
+
+//=============================================================================
+template <typename T, typename C>
+bool TFlatSet<T,C>::Add (const T & value)
+{
+    return Add(T(value));
+}
+
+//=============================================================================
+template <typename T, typename C>
+bool TFlatSet<T,C>::Add (T && value)
+{
+    const uint index = LowerBound(value);
+    if (index < Count() && !m_comp(value, m_array[index]))
+        return false;
+
+    // Append then rotate into place to avoid a second shifting pass
+    m_array.Add(std::forward<T>(value));
+    std::rotate(m_array.Ptr() + index, m_array.Top(), m_array.Term());
+    return true;
+}
+
+//=============================================================================
+template <typename T, typename C>
+bool TFlatSet<T,C>::Remove (const T & key)
+{
+    const uint index = Find(key);
+    if (index >= Count())
+        return false;
+
+    m_array.RemoveOrdered(index);
+    return true;
+}
+
+//=============================================================================
+template <typename T, typename C>
+const T * TFlatSet<T,C>::Ptr () const
+{
+    return m_array.Ptr();
+}
+
+//=============================================================================
+template <typename T, typename C>
+const T & TFlatSet<T,C>::operator[] (uint index) const
+{
+    return m_array[index];
+}
+
+//=============================================================================
+template <typename T, typename C>
+const T * TFlatSet<T,C>::begin () const
+{
+    return m_array.begin();
+}
+
+//=============================================================================
+template <typename T, typename C>
+const T * TFlatSet<T,C>::end () const
+{
+    return m_array.end();
+}
+
+//=============================================================================
+template <typename T, typename C>
+uint TFlatSet<T,C>::LowerBound (const T & key) const
+{
+    const T * it = std::lower_bound(m_array.begin(), m_array.end(), key, m_comp);
+    return uint(it - m_array.begin());
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+//*****************************************************************************
+//
+// TInlineArray
+//
+// Same interface as TArray, but the first N elements are stored inside the
+// object itself. The heap is only touched once the array grows past N.
+//
+//*****************************************************************************
+
+template <typename T, uint N>
+class TInlineArray
+{
+    static_assert(N > 0, "Inline capacity must be non-zero");
+
+public:
+    inline TInlineArray ();
+    inline TInlineArray (const TInlineArray<T, N> & rhs);
+    inline TInlineArray (TInlineArray<T, N> && rhs);
+    inline ~TInlineArray ();
+
+    inline TInlineArray<T, N> & operator= (const TInlineArray<T, N> & rhs);
+    inline TInlineArray<T, N> & operator= (TInlineArray<T, N> && rhs);
+
+    inline bool IsEmpty () const;
+    inline bool IsInline () const;
+
+    inline void Add (const T & value);
+    inline void Add (T && value);
+    inline void Add (const TInlineArray<T, N> & arr);
+    inline void Add (const T values[], uint count);
+    inline T *  New ();
+    inline void RemoveUnordered (uint index);
+    inline void RemoveOrdered (uint index);
+    inline void RemoveOrdered (uint first, uint term);
+    inline void Clear ();
+    inline void Reserve (uint count);
+    inline void ReserveAdditional (uint count);
+    inline void Resize (uint count);
+
+    inline uint Find (const T & value) const;
+    template <typename U>
+    inline uint Find (const U & value) const;
+    inline bool Contains (const T & value) const;
+    inline uint Index (const T * ptr) const;
+
+    inline T * Ptr ();
+    inline const T * Ptr () const;
+    inline T * Term ();
+    inline const T * Term () const;
+    inline T * Top ();
+    inline const T * Top () const;
+    inline uint Count () const;
+    inline uint Capacity () const;
+    inline const T & operator[] (uint index) const;
+    inline T &       operator[] (uint index);
+
+public:
+
+    template <typename Y, uint M>
+    friend bool operator== (const TInlineArray<Y, M> & lhs, const TInlineArray<Y, M> & rhs);
+
+    template <typename Y, uint M>
+    friend bool operator<  (const TInlineArray<Y, M> & lhs, const TInlineArray<Y, M> & rhs);
+
+public:
+
+    const T * begin () const;
+    T * begin ();
+
+    const T * end () const;
+    T * end ();
+
+private:
+    T *     m_ptr;
+    uint    m_count;
+    uint    m_capacity;
+    alignas(T) byte m_inline[sizeof(T) * N];
+
+    inline T * InlinePtr ();
+    inline void Grow (uint minCapacity);
+    inline void Release ();
+    inline void StealFrom (TInlineArray<T, N> & rhs);
+};
@@ -0,0 +1,432 @@
+//*****************************************************************************
+//
+// TInlineArray
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, uint N>
+TInlineArray<T, N>::TInlineArray () :
+    m_ptr(InlinePtr()),
+    m_count(0),
+    m_capacity(N)
+{
+}
+
+//=============================================================================
+template <typename T, uint N>
+TInlineArray<T, N>::TInlineArray (const TInlineArray<T, N> & rhs) :
+    TInlineArray()
+{
+    Add(rhs);
+}
+
+//=============================================================================
+template <typename T, uint N>
+TInlineArray<T, N>::TInlineArray (TInlineArray<T, N> && rhs) :
+    TInlineArray()
+{
+    StealFrom(rhs);
+}
+
+//=============================================================================
+template <typename T, uint N>
+TInlineArray<T, N>::~TInlineArray ()
+{
+    Release();
+}
+
+//=============================================================================
+template <typename T, uint N>
+TInlineArray<T, N> & TInlineArray<T, N>::operator= (const TInlineArray<T, N> & rhs)
+{
+    if (this != &rhs)
+    {
+        Clear();
+        Add(rhs);
+    }
+    return *this;
+}
+
+//=============================================================================
+template <typename T, uint N>
+TInlineArray<T, N> & TInlineArray<T, N>::operator= (TInlineArray<T, N> && rhs)
+{
+    if (this != &rhs)
+    {
+        Release();
+        StealFrom(rhs);
+    }
+    return *this;
+}
+
+//=============================================================================
+template <typename T, uint N>
+bool TInlineArray<T, N>::IsEmpty () const
+{
+    return m_count == 0;
+}
+
+//=============================================================================
+template <typename T, uint N>
+bool TInlineArray<T, N>::IsInline () const
+{
+    return m_ptr == (const T *)m_inline;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Add (const T & value)
+{
+    if (m_count == m_capacity)
+    {
+        // value may live inside this array, so copy it before relocating
+        T copy(value);
+        Grow(m_count + 1);
+        new(m_ptr + m_count) T(std::move(copy));
+    }
+    else
+    {
+        new(m_ptr + m_count) T(value);
+    }
+    m_count++;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Add (T && value)
+{
+    if (m_count == m_capacity)
+    {
+        T temp(std::move(value));
+        Grow(m_count + 1);
+        new(m_ptr + m_count) T(std::move(temp));
+    }
+    else
+    {
+        new(m_ptr + m_count) T(std::move(value));
+    }
+    m_count++;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Add (const TInlineArray<T, N> & arr)
+{
+    Add(arr.Ptr(), arr.Count());
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Add (const T values[], uint count)
+{
+    ASSERT(values + count <= m_ptr || values >= m_ptr + m_capacity); // Cannot add from self
+
+    ReserveAdditional(count);
+    for (uint i = 0; i < count; ++i)
+        new(m_ptr + m_count + i) T(values[i]);
+    m_count += count;
+}
+
+//=============================================================================
+template <typename T, uint N>
+T * TInlineArray<T, N>::New ()
+{
+    ReserveAdditional(1);
+    T * obj = new(m_ptr + m_count) T();
+    m_count++;
+    return obj;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::RemoveUnordered (uint index)
+{
+    ASSERT(index < m_count);
+
+    m_ptr[index] = std::move(m_ptr[m_count - 1]);
+    m_ptr[m_count - 1].~T();
+    m_count--;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::RemoveOrdered (uint index)
+{
+    RemoveOrdered(index, index + 1);
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::RemoveOrdered (uint first, uint term)
+{
+    ASSERT(first <= term);
+    ASSERT(term <= m_count);
+
+    T * dst = std::move(m_ptr + term, m_ptr + m_count, m_ptr + first);
+    for (T * ptr = dst; ptr < m_ptr + m_count; ++ptr)
+        ptr->~T();
+
+    m_count -= term - first;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Clear ()
+{
+    for (T * ptr = m_ptr, * term = m_ptr + m_count; ptr < term; ++ptr)
+        ptr->~T();
+    m_count = 0;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Reserve (uint count)
+{
+    if (count > m_capacity)
+        Grow(count);
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::ReserveAdditional (uint count)
+{
+    Reserve(m_count + count);
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Resize (uint count)
+{
+    if (count < m_count)
+    {
+        for (T * ptr = m_ptr + count, * term = m_ptr + m_count; ptr < term; ++ptr)
+            ptr->~T();
+    }
+    else
+    {
+        Reserve(count);
+        for (T * ptr = m_ptr + m_count, * term = m_ptr + count; ptr < term; ++ptr)
+            new(ptr) T();
+    }
+    m_count = count;
+}
+
+//=============================================================================
+template <typename T, uint N>
+uint TInlineArray<T, N>::Find (const T & value) const
+{
+    const T * it = std::find(begin(), end(), value);
+    return uint(it - begin());
+}
+
+//=============================================================================
+template <typename T, uint N>
+template <typename U>
+uint TInlineArray<T, N>::Find (const U & value) const
+{
+    const T * it = std::find(begin(), end(), value);
+    return uint(it - begin());
+}
+
+//=============================================================================
+template <typename T, uint N>
+bool TInlineArray<T, N>::Contains (const T & value) const
+{
+    return Find(value) < Count();
+}
+
+//=============================================================================
+template <typename T, uint N>
+uint TInlineArray<T, N>::Index (const T * ptr) const
+{
+    const ptrdiff_t index = ptr - Ptr();
+    if (index >= 0 && index < ptrdiff_t(Count()))
+        return uint(index);
+    return (uint)-1;
+}
+
+//=============================================================================
+template <typename T, uint N>
+T * TInlineArray<T, N>::Ptr ()
+{
+    return m_ptr;
+}
+
+//=============================================================================
+template <typename T, uint N>
+const T * TInlineArray<T, N>::Ptr () const
+{
+    return m_ptr;
+}
+
+//=============================================================================
+template <typename T, uint N>
+T * TInlineArray<T, N>::Term ()
+{
+    return m_ptr + m_count;
+}
+
+//=============================================================================
+template <typename T, uint N>
+const T * TInlineArray<T, N>::Term () const
+{
+    return m_ptr + m_count;
+}
+
+//=============================================================================
+template <typename T, uint N>
+T * TInlineArray<T, N>::Top ()
+{
+    ASSERT(m_count > 0);
+    return m_ptr + m_count - 1;
+}
+
+//=============================================================================
+template <typename T, uint N>
+const T * TInlineArray<T, N>::Top () const
+{
+    ASSERT(m_count > 0);
+    return m_ptr + m_count - 1;
+}
+
+//=============================================================================
+template <typename T, uint N>
+uint TInlineArray<T, N>::Count () const
+{
+    return m_count;
+}
+
+//=============================================================================
+template <typename T, uint N>
+uint TInlineArray<T, N>::Capacity () const
+{
+    return m_capacity;
+}
+
+//=============================================================================
+template <typename T, uint N>
+const T & TInlineArray<T, N>::operator[] (uint index) const
+{
+    ASSERT(index < m_count);
+    return m_ptr[index];
+}
+
+//=============================================================================
+template <typename T, uint N>
+T & TInlineArray<T, N>::operator[] (uint index)
+{
+    ASSERT(index < m_count);
+    return m_ptr[index];
+}
+
+//=============================================================================
+template <typename T, uint N>
+const T * TInlineArray<T, N>::begin () const
+{
+    return Ptr();
+}
+
+//=============================================================================
+template <typename T, uint N>
+T * TInlineArray<T, N>::begin ()
+{
+    return Ptr();
+}
+
+//=============================================================================
+template <typename T, uint N>
+const T * TInlineArray<T, N>::end () const
+{
+    return Term();
+}
+
+//=============================================================================
+template <typename T, uint N>
+T * TInlineArray<T, N>::end ()
+{
+    return Term();
+}
+
+//=============================================================================
+template <typename T, uint N>
+T * TInlineArray<T, N>::InlinePtr ()
+{
+    return (T *)m_inline;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Grow (uint minCapacity)
+{
+    ASSERT(minCapacity > m_capacity);
+
+    const uint capacity = Max(minCapacity, m_capacity * 2);
+    T * data = (T *)MemAllocAligned(sizeof(T) * capacity, alignof(T));
+
+    for (uint i = 0; i < m_count; ++i)
+    {
+        new(data + i) T(std::move(m_ptr[i]));
+        m_ptr[i].~T();
+    }
+
+    if (!IsInline())
+        MemFreeAligned(m_ptr, alignof(T));
+
+    m_ptr      = data;
+    m_capacity = capacity;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::Release ()
+{
+    Clear();
+
+    if (!IsInline())
+        MemFreeAligned(m_ptr, alignof(T));
+
+    m_ptr      = InlinePtr();
+    m_capacity = N;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TInlineArray<T, N>::StealFrom (TInlineArray<T, N> & rhs)
+{
+    ASSERT(IsInline() && IsEmpty());
+
+    if (rhs.IsInline())
+    {
+        // Inline elements cannot be stolen, they must be moved one by one
+        for (uint i = 0; i < rhs.m_count; ++i)
+            new(m_ptr + i) T(std::move(rhs.m_ptr[i]));
+        m_count = rhs.m_count;
+        rhs.Clear();
+    }
+    else
+    {
+        m_ptr      = rhs.m_ptr;
+        m_count    = rhs.m_count;
+        m_capacity = rhs.m_capacity;
+
+        rhs.m_ptr      = rhs.InlinePtr();
+        rhs.m_count    = 0;
+        rhs.m_capacity = N;
+    }
+}
+
+
+//=============================================================================
+template <typename Y, uint M>
+bool operator== (const TInlineArray<Y, M> & lhs, const TInlineArray<Y, M> & rhs)
+{
+    return lhs.Count() == rhs.Count() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+//=============================================================================
+template <typename Y, uint M>
+bool operator< (const TInlineArray<Y, M> & lhs, const TInlineArray<Y, M> & rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+
+//*****************************************************************************
+//
+// TMpmcQueue
+//
+// Bounded lock-free queue for any number of producer and consumer threads,
+// after Dmitry Vyukov's bounded MPMC queue. Every cell carries a sequence
+// number that tells producers and consumers whether it is ready for them, so
+// a push or pop costs a single compare-exchange on the shared index in the
+// uncontended case. Capacity is fixed at construction and rounded up to a
+// power of two.
+//
+// Push and Pop return false instead of blocking. The batch versions stop at
+// the first failure and return the number of elements transferred; they are
+// not atomic as a group, so other threads' elements may interleave.
+//
+//*****************************************************************************
+
+template <typename T>
+class TMpmcQueue
+{
+public:
+    explicit TMpmcQueue (uint capacity);
+    ~TMpmcQueue ();
+
+    uint Capacity () const;
+    uint CountApprox () const;
+    bool IsEmptyApprox () const;
+
+    bool Push (const T & value);
+    bool Push (T && value);
+    uint Push (const T values[], uint count);
+
+    bool Pop (T * value);
+    uint Pop (T values[], uint count);
+
+private:
+    CLASS_NO_COPY(TMpmcQueue);
+
+    struct Cell
+    {
+        std::atomic<uint>    sequence;
+        alignas(T) byte      storage[sizeof(T)];
+
+        T * Value () { return (T *)storage; }
+    };
+
+    // Shared, read only after construction
+    alignas(CACHE_LINE_SIZE) Cell * m_cells;
+    uint                            m_mask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint> m_tail;    // Next push position
+    alignas(CACHE_LINE_SIZE) std::atomic<uint> m_head;    // Next pop position
+
+    Cell * ClaimPush ();
+    Cell * ClaimPop ();
+};
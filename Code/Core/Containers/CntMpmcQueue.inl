@@ -0,0 +1,186 @@
+//*****************************************************************************
+//
+// TMpmcQueue
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T>
+TMpmcQueue<T>::TMpmcQueue (uint capacity) :
+    m_cells(null),
+    m_mask(0),
+    m_tail(0),
+    m_head(0)
+{
+    ASSERT(capacity >= 2 && capacity <= (1u << 31));
+
+    capacity = Math::NextPowerTwo(capacity);
+    m_cells  = (Cell *)MemAllocAligned(sizeof(Cell) * capacity, alignof(Cell));
+    m_mask   = capacity - 1;
+
+    for (uint i = 0; i < capacity; ++i)
+        new(&m_cells[i].sequence) std::atomic<uint>(i);
+}
+
+//=============================================================================
+template <typename T>
+TMpmcQueue<T>::~TMpmcQueue ()
+{
+    const uint tail = m_tail.load(std::memory_order_relaxed);
+    for (uint head = m_head.load(std::memory_order_relaxed); head != tail; ++head)
+        m_cells[head & m_mask].Value()->~T();
+
+    MemFreeAligned(m_cells, alignof(Cell));
+}
+
+//=============================================================================
+template <typename T>
+uint TMpmcQueue<T>::Capacity () const
+{
+    return m_mask + 1;
+}
+
+//=============================================================================
+template <typename T>
+uint TMpmcQueue<T>::CountApprox () const
+{
+    const uint head = m_head.load(std::memory_order_relaxed);
+    const uint tail = m_tail.load(std::memory_order_relaxed);
+
+    // The two loads are not taken together, so clamp a transiently negative result
+    const sint count = sint(tail - head);
+    return count > 0 ? Min(uint(count), Capacity()) : 0;
+}
+
+//=============================================================================
+template <typename T>
+bool TMpmcQueue<T>::IsEmptyApprox () const
+{
+    return CountApprox() == 0;
+}
+
+//=============================================================================
+template <typename T>
+bool TMpmcQueue<T>::Push (const T & value)
+{
+    Cell * cell = ClaimPush();
+    if (!cell)
+        return false;
+
+    const uint pos = cell->sequence.load(std::memory_order_relaxed);
+    new(cell->storage) T(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+//=============================================================================
+template <typename T>
+bool TMpmcQueue<T>::Push (T && value)
+{
+    Cell * cell = ClaimPush();
+    if (!cell)
+        return false;
+
+    const uint pos = cell->sequence.load(std::memory_order_relaxed);
+    new(cell->storage) T(std::move(value));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+//=============================================================================
+template <typename T>
+uint TMpmcQueue<T>::Push (const T values[], uint count)
+{
+    uint pushed = 0;
+    while (pushed < count && Push(values[pushed]))
+        ++pushed;
+    return pushed;
+}
+
+//=============================================================================
+template <typename T>
+bool TMpmcQueue<T>::Pop (T * value)
+{
+    ASSERT(value);
+
+    Cell * cell = ClaimPop();
+    if (!cell)
+        return false;
+
+    const uint pos = cell->sequence.load(std::memory_order_relaxed);
+    T * slot = cell->Value();
+    *value = std::move(*slot);
+    slot->~T();
+
+    // Hand the cell to the producer one lap ahead
+    cell->sequence.store(pos + m_mask, std::memory_order_release);
+    return true;
+}
+
+//=============================================================================
+template <typename T>
+uint TMpmcQueue<T>::Pop (T values[], uint count)
+{
+    uint popped = 0;
+    while (popped < count && Pop(&values[popped]))
+        ++popped;
+    return popped;
+}
+
+//=============================================================================
+template <typename T>
+typename TMpmcQueue<T>::Cell * TMpmcQueue<T>::ClaimPush ()
+{
+    uint pos = m_tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell * cell = &m_cells[pos & m_mask];
+        const uint seq  = cell->sequence.load(std::memory_order_acquire);
+        const sint diff = sint(seq - pos);
+
+        if (diff == 0)
+        {
+            // Cell is free for this lap, try to claim the position
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return cell;
+        }
+        else if (diff < 0)
+        {
+            // Consumer has not released the cell from the previous lap
+            return null;
+        }
+        else
+        {
+            // Another producer claimed it first
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+//=============================================================================
+template <typename T>
+typename TMpmcQueue<T>::Cell * TMpmcQueue<T>::ClaimPop ()
+{
+    uint pos = m_head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell * cell = &m_cells[pos & m_mask];
+        const uint seq  = cell->sequence.load(std::memory_order_acquire);
+        const sint diff = sint(seq - (pos + 1));
+
+        if (diff == 0)
+        {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return cell;
+        }
+        else if (diff < 0)
+        {
+            // Producer has not filled the cell yet
+            return null;
+        }
+        else
+        {
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+}
@@ -1,35 +1,69 @@
 #pragma once
 
-#include <queue>
-
 //*****************************************************************************
 //
 // TPriQueue
 //
+// Indexed 4-ary heap. Push returns a handle that stays valid until the value
+// leaves the queue, so callers can change a value's priority in place and
+// re-sift it with Update/DecreaseKey in O(log n) rather than resorting the
+// whole queue. ContainsHandle and Get are O(1).
+//
+// As with std::priority_queue, Peek returns the value for which no other
+// value compares greater.
+//
 //*****************************************************************************
 
 template <typename T, typename C = std::less<T>>
 class TPriQueue
 {
+public:
+    typedef uint Handle;
+    static const Handle INVALID_HANDLE = (Handle)-1;
+
 public:
     TPriQueue ();
     ~TPriQueue ();
-    
+
     uint Count () const;
     bool IsEmpty () const;
 
     void Clear ();
 
     bool Contains (const T & value) const;
+    bool ContainsHandle (Handle handle) const;
 
     void Resort ();
 
-    void Push (const T & value);
+    Handle Push (const T & value);
     T Pop ();
     const T & Peek () const;
 
+    const T & Get (Handle handle) const;
+    T &       Get (Handle handle);
+    void      Update (Handle handle);       // Priority of the value changed in either direction
+    void      DecreaseKey (Handle handle);  // Priority of the value only moved towards the top
+    T         Remove (Handle handle);
+
 private:
 
-    std::deque<T> m_queue;
-    C   m_comp;
+    static const uint ARITY = 4;
+
+    struct Entry
+    {
+        T      value;
+        Handle handle;
+    };
+
+    TArray<Entry>  m_heap;
+    TArray<uint>   m_positions;     // Handle -> index into m_heap
+    TArray<Handle> m_freeHandles;
+    C              m_comp;
+
+    Handle AllocHandle ();
+    void   FreeHandle (Handle handle);
+    void   Place (uint index, Entry && entry);
+    bool   SiftUp (uint index);
+    void   SiftDown (uint index);
+    T      RemoveAt (uint index);
 };
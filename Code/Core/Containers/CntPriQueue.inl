@@ -5,6 +5,9 @@
 //
 //*****************************************************************************
 
+//=============================================================================
+template <typename T, typename C> const typename TPriQueue<T,C>::Handle TPriQueue<T,C>::INVALID_HANDLE;
+
 //=============================================================================
 template <typename T, typename C>
 TPriQueue<T,C>::TPriQueue ()
@@ -21,58 +24,238 @@ TPriQueue<T,C>::~TPriQueue ()
 template <typename T, typename C>
 uint TPriQueue<T,C>::Count () const
 {
-    return m_queue.size();
+    return m_heap.Count();
 }
 
 //=============================================================================
 template <typename T, typename C>
 bool TPriQueue<T,C>::IsEmpty () const
 {
-    return m_queue.empty();
+    return m_heap.IsEmpty();
 }
 
 //=============================================================================
 template <typename T, typename C>
 void TPriQueue<T,C>::Clear ()
 {
-    m_queue.clear();
+    m_heap.Clear();
+    m_positions.Clear();
+    m_freeHandles.Clear();
 }
 
 //=============================================================================
 template <typename T, typename C>
 bool TPriQueue<T,C>::Contains (const T & value) const
 {
-    return std::find(m_queue.begin(), m_queue.end(), value) != m_queue.end();
+    for (const Entry & entry : m_heap)
+    {
+        if (entry.value == value)
+            return true;
+    }
+    return false;
+}
+
+//=============================================================================
+template <typename T, typename C>
+bool TPriQueue<T,C>::ContainsHandle (Handle handle) const
+{
+    return handle < m_positions.Count() && m_positions[handle] != INVALID_HANDLE;
 }
 
 //=============================================================================
 template <typename T, typename C>
 void TPriQueue<T,C>::Resort ()
 {
-    std::make_heap(m_queue.begin(), m_queue.end(), m_comp);
+    // Floyd's heap construction, sift down every parent from the bottom up
+    const uint count = m_heap.Count();
+    if (count < 2)
+        return;
+
+    for (uint index = (count - 2) / ARITY + 1; index-- > 0; )
+        SiftDown(index);
 }
 
 //=============================================================================
 template <typename T, typename C>
-void TPriQueue<T,C>::Push (const T & value)
+typename TPriQueue<T,C>::Handle TPriQueue<T,C>::Push (const T & value)
 {
-    m_queue.push_back(value);
-    std::push_heap(m_queue.begin(), m_queue.end(), m_comp);
+    const Handle handle = AllocHandle();
+    const uint index = m_heap.Count();
+
+    Entry * entry = m_heap.New();
+    entry->value  = value;
+    entry->handle = handle;
+    m_positions[handle] = index;
+
+    SiftUp(index);
+    return handle;
 }
 
 //=============================================================================
 template <typename T, typename C>
 T TPriQueue<T,C>::Pop ()
 {
-    T value = Peek();
-    std::pop_heap(m_queue.begin(), m_queue.end(), m_comp);
-    m_queue.pop_back();
-    return value;
+    ASSERT(!IsEmpty());
+    return RemoveAt(0);
 }
 
 //=============================================================================
 template <typename T, typename C>
 const T & TPriQueue<T,C>::Peek () const
 {
-    return m_queue.front();
+    ASSERT(!IsEmpty());
+    return m_heap[0].value;
+}
+
+//=============================================================================
+template <typename T, typename C>
+const T & TPriQueue<T,C>::Get (Handle handle) const
+{
+    ASSERT(ContainsHandle(handle));
+    return m_heap[m_positions[handle]].value;
+}
+
+//=============================================================================
+template <typename T, typename C>
+T & TPriQueue<T,C>::Get (Handle handle)
+{
+    ASSERT(ContainsHandle(handle));
+    return m_heap[m_positions[handle]].value;
+}
+
+//=============================================================================
+template <typename T, typename C>
+void TPriQueue<T,C>::Update (Handle handle)
+{
+    ASSERT(ContainsHandle(handle));
+
+    const uint index = m_positions[handle];
+    if (!SiftUp(index))
+        SiftDown(index);
+}
+
+//=============================================================================
+template <typename T, typename C>
+void TPriQueue<T,C>::DecreaseKey (Handle handle)
+{
+    ASSERT(ContainsHandle(handle));
+
+    SiftUp(m_positions[handle]);
+}
+
+//=============================================================================
+template <typename T, typename C>
+T TPriQueue<T,C>::Remove (Handle handle)
+{
+    ASSERT(ContainsHandle(handle));
+
+    return RemoveAt(m_positions[handle]);
+}
+
+//=============================================================================
+template <typename T, typename C>
+typename TPriQueue<T,C>::Handle TPriQueue<T,C>::AllocHandle ()
+{
+    if (m_freeHandles.IsEmpty())
+    {
+        m_positions.Add(INVALID_HANDLE);
+        return m_positions.Count() - 1;
+    }
+
+    const Handle handle = *m_freeHandles.Top();
+    m_freeHandles.RemoveOrdered(m_freeHandles.Count() - 1);
+    return handle;
+}
+
+//=============================================================================
+template <typename T, typename C>
+void TPriQueue<T,C>::FreeHandle (Handle handle)
+{
+    m_positions[handle] = INVALID_HANDLE;
+    m_freeHandles.Add(handle);
+}
+
+//=============================================================================
+template <typename T, typename C>
+void TPriQueue<T,C>::Place (uint index, Entry && entry)
+{
+    m_positions[entry.handle] = index;
+    m_heap[index] = std::move(entry);
+}
+
+//=============================================================================
+template <typename T, typename C>
+bool TPriQueue<T,C>::SiftUp (uint index)
+{
+    const uint start = index;
+    Entry entry = std::move(m_heap[index]);
+
+    while (index > 0)
+    {
+        const uint parent = (index - 1) / ARITY;
+        if (!m_comp(m_heap[parent].value, entry.value))
+            break;
+
+        Place(index, std::move(m_heap[parent]));
+        index = parent;
+    }
+
+    Place(index, std::move(entry));
+    return index != start;
+}
+
+//=============================================================================
+template <typename T, typename C>
+void TPriQueue<T,C>::SiftDown (uint index)
+{
+    const uint count = m_heap.Count();
+    Entry entry = std::move(m_heap[index]);
+
+    for (;;)
+    {
+        const uint first = index * ARITY + 1;
+        if (first >= count)
+            break;
+
+        // Find the greatest of up to four children
+        const uint term = Min(first + ARITY, count);
+        uint best = first;
+        for (uint child = first + 1; child < term; ++child)
+        {
+            if (m_comp(m_heap[best].value, m_heap[child].value))
+                best = child;
+        }
+
+        if (!m_comp(entry.value, m_heap[best].value))
+            break;
+
+        Place(index, std::move(m_heap[best]));
+        index = best;
+    }
+
+    Place(index, std::move(entry));
+}
+
+//=============================================================================
+template <typename T, typename C>
+T TPriQueue<T,C>::RemoveAt (uint index)
+{
+    T value = std::move(m_heap[index].value);
+    FreeHandle(m_heap[index].handle);
+
+    const uint last = m_heap.Count() - 1;
+    if (index != last)
+    {
+        Place(index, std::move(m_heap[last]));
+        m_heap.RemoveOrdered(last);
+
+        if (!SiftUp(index))
+            SiftDown(index);
+    }
+    else
+    {
+        m_heap.RemoveOrdered(last);
+    }
+
+    return value;
 }
@@ -1,11 +1,25 @@
 #pragma once
 
-#include <deque>
+#include <iterator>
 
 //*****************************************************************************
 //
 // TQueue
 //
+// Double ended queue stored in a power-of-two ring buffer. Besides the usual
+// element access it exposes the underlying memory as contiguous spans so that
+// producers and consumers can memcpy or issue syscalls directly into and out
+// of the buffer:
+//
+//      uint count = bytesWanted;
+//      byte * dst = queue.ReserveWrite(&count);   // count = contiguous space
+//      count = Recv(dst, count);
+//      queue.CommitWrite(count);
+//
+//      const byte * src = queue.PeekContiguous(&count);
+//      count = Send(src, count);
+//      queue.CommitRead(count);
+//
 //*****************************************************************************
 
 template <typename T>
@@ -17,6 +31,7 @@ public:
     inline TQueue (TQueue<T> && rhs);
     inline ~TQueue ();
 
+    inline TQueue<T> & operator= (const TQueue<T> & rhs);
     inline TQueue<T> & operator= (TQueue<T> && rhs);
 
     inline bool IsEmpty () const;
@@ -30,10 +45,12 @@ public:
     inline void AddBack (const TArray<T> & arr);
     inline void AddBack (const T values[], uint count);
     inline void RemoveFront ();
+    inline void RemoveFront (T values[], uint count);
     inline void RemoveBack ();
     inline void Remove (uint index);
     inline void Remove (uint first, uint term);
     inline void Clear ();
+    inline void Reserve (uint count);
 
     inline uint Find (const T & value) const;
     template <typename U>
@@ -41,13 +58,56 @@ public:
     inline bool Contains (const T & value) const;
 
     inline uint Count () const;
+    inline uint Capacity () const;
     inline const T & operator[] (sint index) const;
     inline T &       operator[] (sint index);
 
+public: // Contiguous span access, trivially copyable types only
+
+    // Contiguous run of elements starting at the front. Returns the number of
+    // elements in the run through count, which may be less than Count() when
+    // the data wraps around the end of the buffer.
+    inline const T * PeekContiguous (uint * count) const;
+    inline void      CommitRead (uint count);
+
+    // Ensures there is room for at least *count more elements, then returns
+    // the contiguous uninitialized run after the back. On return count holds
+    // the length of that run, which may be less than requested when the free
+    // space wraps; call again after CommitWrite for the remainder.
+    inline T *       ReserveWrite (uint * count);
+    inline void      CommitWrite (uint count);
+
+private:
+
+    template <typename Q, typename V>
+    class TIterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef V                         value_type;
+        typedef ptrdiff_t                 difference_type;
+        typedef V *                       pointer;
+        typedef V &                       reference;
+
+        TIterator (Q * queue, uint index) : m_queue(queue), m_index(index) {}
+
+        V & operator* () const { return m_queue->Slot(m_index); }
+        V * operator-> () const { return &m_queue->Slot(m_index); }
+        TIterator & operator++ () { ++m_index; return *this; }
+        TIterator operator++ (int) { TIterator it = *this; ++m_index; return it; }
+
+        bool operator== (const TIterator & rhs) const { return m_index == rhs.m_index; }
+        bool operator!= (const TIterator & rhs) const { return m_index != rhs.m_index; }
+
+    private:
+        Q *  m_queue;
+        uint m_index;
+    };
+
 public:
 
-    typedef typename std::deque<T>::iterator CIterator;
-    typedef typename std::deque<T>::const_iterator CConstIterator;
+    typedef TIterator<TQueue<T>, T>             CIterator;
+    typedef TIterator<const TQueue<T>, const T> CConstIterator;
 
 public:
 
@@ -58,7 +118,7 @@ public:
     friend bool operator<  (const TQueue<Y> & lhs, const TQueue<Y> & rhs);
 
 public:
-    
+
     CIterator begin ();
     CConstIterator begin () const;
 
@@ -67,5 +127,16 @@ public:
 
 private:
 
-    std::deque<T> m_data;
-};
\ No newline at end of file
+    static const uint MIN_CAPACITY = 16;
+
+    T *  m_data;
+    uint m_capacity;    // Always zero or a power of two
+    uint m_head;
+    uint m_count;
+
+    inline uint Mask () const { return m_capacity - 1; }
+    inline T &       Slot (uint index);
+    inline const T & Slot (uint index) const;
+    inline void      Grow (uint minCapacity);
+    inline void      EnsureAdditional (uint count);
+};
@@ -1,4 +1,3 @@
-
 //*****************************************************************************
 //
 // TQueue
@@ -7,71 +6,138 @@
 
 //=============================================================================
 template <typename T>
-TQueue<T>::TQueue ()
+TQueue<T>::TQueue () :
+    m_data(null),
+    m_capacity(0),
+    m_head(0),
+    m_count(0)
 {
 }
 
 //=============================================================================
 template <typename T>
 TQueue<T>::TQueue (const TQueue<T> & rhs) :
-    m_data(rhs.m_data)
+    TQueue()
 {
+    Reserve(rhs.Count());
+    for (const T & value : rhs)
+        AddBack(value);
 }
 
 //=============================================================================
 template <typename T>
 TQueue<T>::TQueue (TQueue<T> && rhs) :
-    m_data(std::forward(rhs.m_data))
+    m_data(rhs.m_data),
+    m_capacity(rhs.m_capacity),
+    m_head(rhs.m_head),
+    m_count(rhs.m_count)
 {
+    rhs.m_data     = null;
+    rhs.m_capacity = 0;
+    rhs.m_head     = 0;
+    rhs.m_count    = 0;
 }
 
 //=============================================================================
 template <typename T>
 TQueue<T>::~TQueue ()
 {
+    Clear();
+    MemFreeAligned(m_data, alignof(T));
+}
+
+//=============================================================================
+template <typename T>
+TQueue<T> & TQueue<T>::operator= (const TQueue<T> & rhs)
+{
+    if (this != &rhs)
+    {
+        Clear();
+        Reserve(rhs.Count());
+        for (const T & value : rhs)
+            AddBack(value);
+    }
+    return *this;
 }
 
 //=============================================================================
 template <typename T>
 TQueue<T> & TQueue<T>::operator= (TQueue<T> && rhs)
 {
-    return m_data == rhs.m_data;
+    if (this != &rhs)
+    {
+        Clear();
+        MemFreeAligned(m_data, alignof(T));
+
+        m_data     = rhs.m_data;
+        m_capacity = rhs.m_capacity;
+        m_head     = rhs.m_head;
+        m_count    = rhs.m_count;
+
+        rhs.m_data     = null;
+        rhs.m_capacity = 0;
+        rhs.m_head     = 0;
+        rhs.m_count    = 0;
+    }
+    return *this;
 }
 
 //=============================================================================
 template <typename T>
 bool TQueue<T>::IsEmpty () const
 {
-    return m_data.empty();
+    return m_count == 0;
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::AddFront (const T & value)
 {
-    m_data.push_front(value);
+    if (m_count == m_capacity)
+    {
+        T copy(value);
+        AddFront(std::move(copy));
+        return;
+    }
+
+    m_head = (m_head - 1) & Mask();
+    new(&m_data[m_head]) T(value);
+    m_count++;
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::AddFront (T && value)
 {
-    m_data.push_front(std::forward(value));
+    if (m_count == m_capacity)
+    {
+        // value may live inside this queue, so take it before relocating
+        T temp(std::move(value));
+        EnsureAdditional(1);
+        m_head = (m_head - 1) & Mask();
+        new(&m_data[m_head]) T(std::move(temp));
+    }
+    else
+    {
+        m_head = (m_head - 1) & Mask();
+        new(&m_data[m_head]) T(std::move(value));
+    }
+    m_count++;
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::AddFront (const TArray<T> & arr)
 {
-    for (const T & value : arr)
-        AddFront(value);
+    AddFront(arr.Ptr(), arr.Count());
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::AddFront (const T values[], uint count)
 {
-    for (const T * ptr = value, term = values + count; ptr < term; ++ptr)
+    EnsureAdditional(count);
+    for (const T * ptr = values, * term = values + count; ptr < term; ++ptr)
         AddFront(*ptr);
 }
 
@@ -79,80 +145,152 @@ void TQueue<T>::AddFront (const T values[], uint count)
 template <typename T>
 void TQueue<T>::AddBack (const T & value)
 {
-    m_data.push_back(value);
+    if (m_count == m_capacity)
+    {
+        T copy(value);
+        AddBack(std::move(copy));
+        return;
+    }
+
+    new(&Slot(m_count)) T(value);
+    m_count++;
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::AddBack (T && value)
 {
-    m_data.push_back(std::forward(value));
+    if (m_count == m_capacity)
+    {
+        // value may live inside this queue, so take it before relocating
+        T temp(std::move(value));
+        EnsureAdditional(1);
+        new(&Slot(m_count)) T(std::move(temp));
+    }
+    else
+    {
+        new(&Slot(m_count)) T(std::move(value));
+    }
+    m_count++;
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::AddBack (const TArray<T> & arr)
 {
-    for (const T & value : arr)
-        AddBack(value);
+    AddBack(arr.Ptr(), arr.Count());
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::AddBack (const T values[], uint count)
 {
-    const T * ptr = values;
-    const T * term = values + count;
-    for ( ; ptr < term; ++ptr)
-        AddBack(*ptr);
+    EnsureAdditional(count);
+
+    // Copy in at most two runs: up to the end of the buffer, then the wrap
+    const uint tail  = (m_head + m_count) & Mask();
+    const uint first = Min(count, m_capacity - tail);
+    std::uninitialized_copy(values, values + first, m_data + tail);
+    std::uninitialized_copy(values + first, values + count, m_data);
+    m_count += count;
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::RemoveFront ()
 {
-    m_data.pop_front();
+    ASSERT(m_count > 0);
+
+    m_data[m_head].~T();
+    m_head = (m_head + 1) & Mask();
+    m_count--;
+}
+
+//=============================================================================
+template <typename T>
+void TQueue<T>::RemoveFront (T values[], uint count)
+{
+    ASSERT(count <= m_count);
+
+    for (T * ptr = values, * term = values + count; ptr < term; ++ptr)
+    {
+        *ptr = std::move(m_data[m_head]);
+        RemoveFront();
+    }
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::RemoveBack ()
 {
-    m_data.pop_back();
+    ASSERT(m_count > 0);
+
+    Slot(m_count - 1).~T();
+    m_count--;
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::Remove (uint index)
 {
-    m_data.erase(std::next(m_data.begin(), index));
+    Remove(index, index + 1);
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::Remove (uint first, uint term)
 {
-    m_data.erase(
-        std::next(m_data.begin(), first),
-        std::next(m_data.begin(), term)
-    );
+    ASSERT(first <= term);
+    ASSERT(term <= m_count);
+
+    const uint removed = term - first;
+    if (!removed)
+        return;
+
+    // Removing from the front only needs to advance the head
+    if (first == 0)
+    {
+        for (uint i = 0; i < removed; ++i)
+            RemoveFront();
+        return;
+    }
+
+    for (uint i = first; i + removed < m_count; ++i)
+        Slot(i) = std::move(Slot(i + removed));
+
+    for (uint i = 0; i < removed; ++i)
+        RemoveBack();
 }
 
 //=============================================================================
 template <typename T>
 void TQueue<T>::Clear ()
 {
-    m_data.clear();
+    for (uint i = 0; i < m_count; ++i)
+        Slot(i).~T();
+
+    m_head  = 0;
+    m_count = 0;
+}
+
+//=============================================================================
+template <typename T>
+void TQueue<T>::Reserve (uint count)
+{
+    if (count > m_capacity)
+        Grow(count);
 }
 
 //=============================================================================
 template <typename T>
 uint TQueue<T>::Find (const T & value) const
 {
-    auto it = std::find(m_data.begin(), m_data.end(), value);
-    if (it == m_data.end())
-        return UINT_MAX;
-    return std::distance(it, m_data.begin());
+    for (uint i = 0; i < m_count; ++i)
+    {
+        if (Slot(i) == value)
+            return i;
+    }
+    return UINT_MAX;
 }
 
 //=============================================================================
@@ -160,10 +298,12 @@ template <typename T>
 template <typename U>
 uint TQueue<T>::Find (const U & value) const
 {
-    auto it = std::find(m_data.begin(), m_data.end(), value);
-    if (it == m_data.end())
-        return UINT_MAX;
-    return std::distance(it, m_data.begin());
+    for (uint i = 0; i < m_count; ++i)
+    {
+        if (Slot(i) == value)
+            return i;
+    }
+    return UINT_MAX;
 }
 
 //=============================================================================
@@ -177,7 +317,14 @@ bool TQueue<T>::Contains (const T & value) const
 template <typename T>
 uint TQueue<T>::Count () const
 {
-    return uint(m_data.size());
+    return m_count;
+}
+
+//=============================================================================
+template <typename T>
+uint TQueue<T>::Capacity () const
+{
+    return m_capacity;
 }
 
 //=============================================================================
@@ -186,7 +333,7 @@ const T & TQueue<T>::operator[] (sint index) const
 {
     ASSERT(Math::IsInRange(index, -(sint)Count(), (sint)Count()));
     const uint i = (index < 0) ? (Count()+index) : index;
-    return m_data[i];
+    return Slot(i);
 }
 
 //=============================================================================
@@ -195,33 +342,143 @@ T & TQueue<T>::operator[] (sint index)
 {
     ASSERT(Math::IsInRange(index, -(sint)Count(), (sint)Count()));
     const uint i = (index < 0) ? (Count()+index) : index;
-    return m_data[i];
+    return Slot(i);
+}
+
+//=============================================================================
+template <typename T>
+const T * TQueue<T>::PeekContiguous (uint * count) const
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Span access requires trivially copyable types");
+    ASSERT(count);
+
+    *count = Min(m_count, m_capacity - m_head);
+    return m_data + m_head;
+}
+
+//=============================================================================
+template <typename T>
+void TQueue<T>::CommitRead (uint count)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Span access requires trivially copyable types");
+    ASSERT(count <= m_count);
+
+    m_head   = (m_head + count) & Mask();
+    m_count -= count;
+
+    // Rewind an empty buffer so the next write gets the largest possible run
+    if (!m_count)
+        m_head = 0;
+}
+
+//=============================================================================
+template <typename T>
+T * TQueue<T>::ReserveWrite (uint * count)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Span access requires trivially copyable types");
+    ASSERT(count);
+
+    EnsureAdditional(*count);
+
+    const uint tail = (m_head + m_count) & Mask();
+    const uint free = m_capacity - m_count;
+    *count = Min(free, m_capacity - tail);
+    return m_data + tail;
+}
+
+//=============================================================================
+template <typename T>
+void TQueue<T>::CommitWrite (uint count)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Span access requires trivially copyable types");
+    ASSERT(m_count + count <= m_capacity);
+
+    m_count += count;
+}
+
+//=============================================================================
+template <typename T>
+T & TQueue<T>::Slot (uint index)
+{
+    return m_data[(m_head + index) & Mask()];
+}
+
+//=============================================================================
+template <typename T>
+const T & TQueue<T>::Slot (uint index) const
+{
+    return m_data[(m_head + index) & Mask()];
+}
+
+//=============================================================================
+template <typename T>
+void TQueue<T>::Grow (uint minCapacity)
+{
+    const uint capacity = Math::NextPowerTwo(Max(minCapacity, (uint)MIN_CAPACITY));
+    T * data = (T *)MemAllocAligned(sizeof(T) * capacity, alignof(T));
+
+    // Unwrap the existing elements to the start of the new buffer
+    for (uint i = 0; i < m_count; ++i)
+    {
+        T & slot = Slot(i);
+        new(data + i) T(std::move(slot));
+        slot.~T();
+    }
+
+    MemFreeAligned(m_data, alignof(T));
+
+    m_data     = data;
+    m_capacity = capacity;
+    m_head     = 0;
+}
+
+//=============================================================================
+template <typename T>
+void TQueue<T>::EnsureAdditional (uint count)
+{
+    if (m_count + count > m_capacity)
+        Grow(m_count + count);
 }
 
 //=============================================================================
 template <typename T>
 typename TQueue<T>::CConstIterator TQueue<T>::begin () const
 {
-    return m_data.cbegin();
+    return CConstIterator(this, 0);
 }
 
 //=============================================================================
 template <typename T>
 typename TQueue<T>::CIterator TQueue<T>::begin ()
 {
-    return m_data.begin();
+    return CIterator(this, 0);
 }
 
 //=============================================================================
 template <typename T>
 typename TQueue<T>::CConstIterator TQueue<T>::end () const
 {
-    return m_data.cend();
+    return CConstIterator(this, m_count);
 }
 
 //=============================================================================
 template <typename T>
 typename TQueue<T>::CIterator TQueue<T>::end ()
 {
-    return m_data.end();
-}
\ No newline at end of file
+    return CIterator(this, m_count);
+}
+
+
+//=============================================================================
+template <typename Y>
+bool operator== (const TQueue<Y> & lhs, const TQueue<Y> & rhs)
+{
+    return lhs.Count() == rhs.Count() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+//=============================================================================
+template <typename Y>
+bool operator< (const TQueue<Y> & lhs, const TQueue<Y> & rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
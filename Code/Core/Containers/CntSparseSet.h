@@ -0,0 +1,62 @@
+#pragma once
+
+//*****************************************************************************
+//
+// TSparseSetIndex
+//
+// Maps a key to the dense integer used to index the sparse array.
+// Specialize for id types that are not implicitly convertible to uint.
+//
+//*****************************************************************************
+
+template <typename T>
+struct TSparseSetIndex
+{
+    static uint Get (const T & key) { return uint(key); }
+};
+
+
+
+//*****************************************************************************
+//
+// TSparseSet
+//
+// Set of small integer-like keys (entity ids, component ids, node indices)
+// stored as a sparse array of positions paired with a dense array of keys.
+// Add, Remove and Contains are O(1) and iteration walks the dense array, but
+// memory grows with the largest key ever added. Removal does not preserve
+// iteration order.
+//
+//*****************************************************************************
+
+template <typename T, typename I = TSparseSetIndex<T>>
+class TSparseSet
+{
+public:
+    TSparseSet ();
+    ~TSparseSet ();
+
+    uint Count () const;
+    bool IsEmpty () const;
+
+    void Clear ();
+    void Reserve (uint maxKey, uint count);
+    bool Contains (const T & key) const;
+
+    bool Add (const T & value);
+    bool Remove (const T & key);
+
+    const T * Ptr () const;
+    const T & operator[] (uint index) const;
+
+public:
+
+    const T * begin () const;
+    const T * end () const;
+
+private:
+    static const uint INVALID = (uint)-1;
+
+    TArray<T>    m_dense;
+    TArray<uint> m_sparse;  // Key index -> position in m_dense
+};
@@ -0,0 +1,136 @@
+//*****************************************************************************
+//
+// TSparseSet
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, typename I> const uint TSparseSet<T,I>::INVALID;
+
+//=============================================================================
+template <typename T, typename I>
+TSparseSet<T,I>::TSparseSet ()
+{
+}
+
+//=============================================================================
+template <typename T, typename I>
+TSparseSet<T,I>::~TSparseSet ()
+{
+}
+
+//=============================================================================
+template <typename T, typename I>
+uint TSparseSet<T,I>::Count () const
+{
+    return m_dense.Count();
+}
+
+//=============================================================================
+template <typename T, typename I>
+bool TSparseSet<T,I>::IsEmpty () const
+{
+    return m_dense.IsEmpty();
+}
+
+//=============================================================================
+template <typename T, typename I>
+void TSparseSet<T,I>::Clear ()
+{
+    // Only touch the sparse entries that are in use
+    for (const T & value : m_dense)
+        m_sparse[I::Get(value)] = INVALID;
+
+    m_dense.Clear();
+}
+
+//=============================================================================
+template <typename T, typename I>
+void TSparseSet<T,I>::Reserve (uint maxKey, uint count)
+{
+    if (maxKey >= m_sparse.Count())
+    {
+        const uint oldCount = m_sparse.Count();
+        m_sparse.Resize(maxKey + 1);
+        std::fill(m_sparse.Ptr() + oldCount, m_sparse.Term(), INVALID);
+    }
+
+    m_dense.Reserve(count);
+}
+
+//=============================================================================
+template <typename T, typename I>
+bool TSparseSet<T,I>::Contains (const T & key) const
+{
+    const uint index = I::Get(key);
+    return index < m_sparse.Count() && m_sparse[index] != INVALID;
+}
+
+//=============================================================================
+template <typename T, typename I>
+bool TSparseSet<T,I>::Add (const T & value)
+{
+    const uint index = I::Get(value);
+    if (index >= m_sparse.Count())
+    {
+        // Grow geometrically so a run of increasing ids does not resize every add
+        const uint oldCount = m_sparse.Count();
+        m_sparse.Resize(Max(index + 1, oldCount * 2));
+        std::fill(m_sparse.Ptr() + oldCount, m_sparse.Term(), INVALID);
+    }
+    else if (m_sparse[index] != INVALID)
+    {
+        return false;
+    }
+
+    m_sparse[index] = m_dense.Count();
+    m_dense.Add(value);
+    return true;
+}
+
+//=============================================================================
+template <typename T, typename I>
+bool TSparseSet<T,I>::Remove (const T & key)
+{
+    if (!Contains(key))
+        return false;
+
+    const uint index    = I::Get(key);
+    const uint position = m_sparse[index];
+
+    // Move the last dense value into the hole
+    const T & last = *m_dense.Top();
+    m_sparse[I::Get(last)] = position;
+    m_dense.RemoveUnordered(position);
+
+    m_sparse[index] = INVALID;
+    return true;
+}
+
+//=============================================================================
+template <typename T, typename I>
+const T * TSparseSet<T,I>::Ptr () const
+{
+    return m_dense.Ptr();
+}
+
+//=============================================================================
+template <typename T, typename I>
+const T & TSparseSet<T,I>::operator[] (uint index) const
+{
+    return m_dense[index];
+}
+
+//=============================================================================
+template <typename T, typename I>
+const T * TSparseSet<T,I>::begin () const
+{
+    return m_dense.begin();
+}
+
+//=============================================================================
+template <typename T, typename I>
+const T * TSparseSet<T,I>::end () const
+{
+    return m_dense.end();
+}
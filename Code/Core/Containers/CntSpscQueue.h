@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+
+//*****************************************************************************
+//
+// TSpscQueue
+//
+// Bounded lock-free ring for exactly one producer thread and one consumer
+// thread. Capacity is fixed at construction and rounded up to a power of two.
+// The producer and consumer indices live on separate cache lines, and each
+// side keeps a cached copy of the other's index so that it only touches the
+// shared line when the ring looks full or empty.
+//
+// Push and Pop return false instead of blocking; the batch versions return
+// the number of elements actually transferred.
+//
+//*****************************************************************************
+
+template <typename T>
+class TSpscQueue
+{
+public:
+    explicit TSpscQueue (uint capacity);
+    ~TSpscQueue ();
+
+    uint Capacity () const;
+    uint CountApprox () const;  // Exact only when called from the producer or consumer with the other idle
+    bool IsEmptyApprox () const;
+
+public: // Producer thread only
+
+    bool Push (const T & value);
+    bool Push (T && value);
+    uint Push (const T values[], uint count);
+
+public: // Consumer thread only
+
+    bool Pop (T * value);
+    uint Pop (T values[], uint count);
+
+private:
+    CLASS_NO_COPY(TSpscQueue);
+
+    // Consumer owned
+    alignas(CACHE_LINE_SIZE) std::atomic<uint> m_head;
+    uint                                       m_tailCache;
+
+    // Producer owned
+    alignas(CACHE_LINE_SIZE) std::atomic<uint> m_tail;
+    uint                                       m_headCache;
+
+    // Shared, read only after construction
+    alignas(CACHE_LINE_SIZE) T * m_data;
+    uint                         m_mask;
+
+    uint ReserveWrite (uint count);
+    uint ReserveRead (uint count);
+};
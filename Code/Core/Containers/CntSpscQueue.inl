@@ -0,0 +1,168 @@
+//*****************************************************************************
+//
+// TSpscQueue
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T>
+TSpscQueue<T>::TSpscQueue (uint capacity) :
+    m_head(0),
+    m_tailCache(0),
+    m_tail(0),
+    m_headCache(0),
+    m_data(null),
+    m_mask(0)
+{
+    // Indices run freely and wrap, so the capacity must leave the top bit clear
+    ASSERT(capacity > 0 && capacity <= (1u << 31));
+
+    capacity = Math::NextPowerTwo(capacity);
+    m_data   = (T *)MemAllocAligned(sizeof(T) * capacity, alignof(T));
+    m_mask   = capacity - 1;
+}
+
+//=============================================================================
+template <typename T>
+TSpscQueue<T>::~TSpscQueue ()
+{
+    const uint tail = m_tail.load(std::memory_order_relaxed);
+    for (uint head = m_head.load(std::memory_order_relaxed); head != tail; ++head)
+        m_data[head & m_mask].~T();
+
+    MemFreeAligned(m_data, alignof(T));
+}
+
+//=============================================================================
+template <typename T>
+uint TSpscQueue<T>::Capacity () const
+{
+    return m_mask + 1;
+}
+
+//=============================================================================
+template <typename T>
+uint TSpscQueue<T>::CountApprox () const
+{
+    const uint head = m_head.load(std::memory_order_acquire);
+    const uint tail = m_tail.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+//=============================================================================
+template <typename T>
+bool TSpscQueue<T>::IsEmptyApprox () const
+{
+    return CountApprox() == 0;
+}
+
+//=============================================================================
+template <typename T>
+bool TSpscQueue<T>::Push (const T & value)
+{
+    if (!ReserveWrite(1))
+        return false;
+
+    const uint tail = m_tail.load(std::memory_order_relaxed);
+    new(&m_data[tail & m_mask]) T(value);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+//=============================================================================
+template <typename T>
+bool TSpscQueue<T>::Push (T && value)
+{
+    if (!ReserveWrite(1))
+        return false;
+
+    const uint tail = m_tail.load(std::memory_order_relaxed);
+    new(&m_data[tail & m_mask]) T(std::move(value));
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+//=============================================================================
+template <typename T>
+uint TSpscQueue<T>::Push (const T values[], uint count)
+{
+    count = ReserveWrite(count);
+
+    const uint tail = m_tail.load(std::memory_order_relaxed);
+    for (uint i = 0; i < count; ++i)
+        new(&m_data[(tail + i) & m_mask]) T(values[i]);
+
+    // Publish the whole batch with a single release
+    m_tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+//=============================================================================
+template <typename T>
+bool TSpscQueue<T>::Pop (T * value)
+{
+    ASSERT(value);
+
+    if (!ReserveRead(1))
+        return false;
+
+    const uint head = m_head.load(std::memory_order_relaxed);
+    T & slot = m_data[head & m_mask];
+    *value = std::move(slot);
+    slot.~T();
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+//=============================================================================
+template <typename T>
+uint TSpscQueue<T>::Pop (T values[], uint count)
+{
+    count = ReserveRead(count);
+
+    const uint head = m_head.load(std::memory_order_relaxed);
+    for (uint i = 0; i < count; ++i)
+    {
+        T & slot = m_data[(head + i) & m_mask];
+        values[i] = std::move(slot);
+        slot.~T();
+    }
+
+    m_head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+//=============================================================================
+template <typename T>
+uint TSpscQueue<T>::ReserveWrite (uint count)
+{
+    const uint tail     = m_tail.load(std::memory_order_relaxed);
+    const uint capacity = m_mask + 1;
+
+    // Only refresh the consumer's index when the cached one says we are full
+    uint free = capacity - (tail - m_headCache);
+    if (free < count)
+    {
+        m_headCache = m_head.load(std::memory_order_acquire);
+        free = capacity - (tail - m_headCache);
+    }
+
+    return Min(free, count);
+}
+
+//=============================================================================
+template <typename T>
+uint TSpscQueue<T>::ReserveRead (uint count)
+{
+    const uint head = m_head.load(std::memory_order_relaxed);
+
+    // Only refresh the producer's index when the cached one says we are empty
+    uint used = m_tailCache - head;
+    if (used < count)
+    {
+        m_tailCache = m_tail.load(std::memory_order_acquire);
+        used = m_tailCache - head;
+    }
+
+    return Min(used, count);
+}
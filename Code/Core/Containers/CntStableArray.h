@@ -0,0 +1,104 @@
+#pragma once
+
+#include <iterator>
+
+//*****************************************************************************
+//
+// TStableArray
+//
+// Array of objects stored in fixed size chunks that are never relocated, so
+// pointers to elements stay valid for as long as the element lives. Deleted
+// slots go on a free list and are reused by the next New. Elements are
+// addressed by a stable index in O(1), and iteration walks each chunk in
+// order, skipping free slots.
+//
+// Use it in place of TArray<T *> plus a new per object when other code keeps
+// raw pointers to the elements.
+//
+//*****************************************************************************
+
+template <typename T, uint N = 64>
+class TStableArray
+{
+    static_assert(N > 0 && N <= 64 && (N & (N - 1)) == 0, "Chunk size must be a power of two no larger than 64");
+
+public:
+    inline TStableArray ();
+    inline ~TStableArray ();
+
+    inline bool IsEmpty () const;
+    inline uint Count () const;
+    inline uint Capacity () const;
+
+    template <typename... Args>
+    inline T *  New (Args &&... args);
+    inline void Delete (uint index);
+    inline void Delete (T * ptr);
+    inline void Clear ();
+
+    inline bool IsValid (uint index) const;
+    inline uint Index (const T * ptr) const;    // O(chunks)
+
+    inline const T & operator[] (uint index) const;
+    inline T &       operator[] (uint index);
+
+private:
+
+    CLASS_NO_COPY(TStableArray);
+
+    template <typename A, typename V>
+    class TIterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef V                         value_type;
+        typedef ptrdiff_t                 difference_type;
+        typedef V *                       pointer;
+        typedef V &                       reference;
+
+        TIterator (A * array, uint index) : m_array(array), m_index(m_array->NextLive(index)) {}
+
+        V & operator* () const { return (*m_array)[m_index]; }
+        V * operator-> () const { return &(*m_array)[m_index]; }
+        TIterator & operator++ () { m_index = m_array->NextLive(m_index + 1); return *this; }
+        TIterator operator++ (int) { TIterator it = *this; ++*this; return it; }
+
+        bool operator== (const TIterator & rhs) const { return m_index == rhs.m_index; }
+        bool operator!= (const TIterator & rhs) const { return m_index != rhs.m_index; }
+
+    private:
+        A *  m_array;
+        uint m_index;
+    };
+
+public:
+
+    typedef TIterator<TStableArray<T, N>, T>             CIterator;
+    typedef TIterator<const TStableArray<T, N>, const T> CConstIterator;
+
+    CIterator begin ();
+    CConstIterator begin () const;
+
+    CIterator end ();
+    CConstIterator end () const;
+
+private:
+
+    struct Chunk
+    {
+        alignas(T) byte storage[sizeof(T) * N];
+        uint64          live;   // Bit per slot in use
+
+        T * Slot (uint i) { return (T *)storage + i; }
+
+        void * operator new (size_t bytes) { return MemAllocAligned(uint(bytes), alignof(Chunk)); }
+        void   operator delete (void * ptr) { MemFreeAligned(ptr, alignof(Chunk)); }
+    };
+
+    TArray<Chunk *> m_chunks;
+    TArray<uint>    m_free;
+    uint            m_count;
+
+    inline T *  Slot (uint index) const;
+    inline uint NextLive (uint index) const;
+};
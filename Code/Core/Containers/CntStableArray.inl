@@ -0,0 +1,205 @@
+//*****************************************************************************
+//
+// TStableArray
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, uint N>
+TStableArray<T, N>::TStableArray () :
+    m_count(0)
+{
+}
+
+//=============================================================================
+template <typename T, uint N>
+TStableArray<T, N>::~TStableArray ()
+{
+    Clear();
+
+    for (Chunk * chunk : m_chunks)
+        delete chunk;
+}
+
+//=============================================================================
+template <typename T, uint N>
+bool TStableArray<T, N>::IsEmpty () const
+{
+    return m_count == 0;
+}
+
+//=============================================================================
+template <typename T, uint N>
+uint TStableArray<T, N>::Count () const
+{
+    return m_count;
+}
+
+//=============================================================================
+template <typename T, uint N>
+uint TStableArray<T, N>::Capacity () const
+{
+    return m_chunks.Count() * N;
+}
+
+//=============================================================================
+template <typename T, uint N>
+template <typename... Args>
+T * TStableArray<T, N>::New (Args &&... args)
+{
+    if (m_free.IsEmpty())
+    {
+        // Push the new chunk's slots so that the lowest index is reused first
+        Chunk * chunk = new Chunk;
+        chunk->live = 0;
+        m_chunks.Add(chunk);
+
+        const uint base = Capacity();
+        for (uint i = base; i-- > base - N; )
+            m_free.Add(i);
+    }
+
+    const uint index = *m_free.Top();
+    m_free.RemoveOrdered(m_free.Count() - 1);
+
+    T * obj = new(Slot(index)) T(std::forward<Args>(args)...);
+    m_chunks[index / N]->live |= uint64(1) << (index % N);
+    m_count++;
+    return obj;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TStableArray<T, N>::Delete (uint index)
+{
+    ASSERT(IsValid(index));
+
+    Slot(index)->~T();
+    m_chunks[index / N]->live &= ~(uint64(1) << (index % N));
+    m_free.Add(index);
+    m_count--;
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TStableArray<T, N>::Delete (T * ptr)
+{
+    Delete(Index(ptr));
+}
+
+//=============================================================================
+template <typename T, uint N>
+void TStableArray<T, N>::Clear ()
+{
+    m_free.Clear();
+
+    for (uint c = m_chunks.Count(); c-- > 0; )
+    {
+        Chunk * chunk = m_chunks[c];
+        for (uint i = N; i-- > 0; )
+        {
+            if (chunk->live & (uint64(1) << i))
+                chunk->Slot(i)->~T();
+            m_free.Add(c * N + i);
+        }
+        chunk->live = 0;
+    }
+
+    m_count = 0;
+}
+
+//=============================================================================
+template <typename T, uint N>
+bool TStableArray<T, N>::IsValid (uint index) const
+{
+    return index < Capacity() && (m_chunks[index / N]->live & (uint64(1) << (index % N)));
+}
+
+//=============================================================================
+template <typename T, uint N>
+uint TStableArray<T, N>::Index (const T * ptr) const
+{
+    for (uint c = 0, count = m_chunks.Count(); c < count; ++c)
+    {
+        const ptrdiff_t offset = ptr - m_chunks[c]->Slot(0);
+        if (offset >= 0 && offset < ptrdiff_t(N))
+            return c * N + uint(offset);
+    }
+    return (uint)-1;
+}
+
+//=============================================================================
+template <typename T, uint N>
+const T & TStableArray<T, N>::operator[] (uint index) const
+{
+    ASSERT(IsValid(index));
+    return *Slot(index);
+}
+
+//=============================================================================
+template <typename T, uint N>
+T & TStableArray<T, N>::operator[] (uint index)
+{
+    ASSERT(IsValid(index));
+    return *Slot(index);
+}
+
+//=============================================================================
+template <typename T, uint N>
+typename TStableArray<T, N>::CIterator TStableArray<T, N>::begin ()
+{
+    return CIterator(this, 0);
+}
+
+//=============================================================================
+template <typename T, uint N>
+typename TStableArray<T, N>::CConstIterator TStableArray<T, N>::begin () const
+{
+    return CConstIterator(this, 0);
+}
+
+//=============================================================================
+template <typename T, uint N>
+typename TStableArray<T, N>::CIterator TStableArray<T, N>::end ()
+{
+    return CIterator(this, Capacity());
+}
+
+//=============================================================================
+template <typename T, uint N>
+typename TStableArray<T, N>::CConstIterator TStableArray<T, N>::end () const
+{
+    return CConstIterator(this, Capacity());
+}
+
+//=============================================================================
+template <typename T, uint N>
+T * TStableArray<T, N>::Slot (uint index) const
+{
+    return m_chunks[index / N]->Slot(index % N);
+}
+
+//=============================================================================
+template <typename T, uint N>
+uint TStableArray<T, N>::NextLive (uint index) const
+{
+    const uint capacity = Capacity();
+    while (index < capacity)
+    {
+        // Mask off the slots before index, then skip to the next live one
+        const uint64 live = m_chunks[index / N]->live >> (index % N);
+        if (live)
+        {
+            uint64 bits = live;
+            while (!(bits & 1))
+            {
+                bits >>= 1;
+                index++;
+            }
+            return index;
+        }
+
+        index = (index / N + 1) * N;
+    }
+    return capacity;
+}
@@ -1,15 +1,31 @@
 #pragma once
 
 #include "CntArray.h"
+#include "CntInlineArray.h"
+#include "CntStableArray.h"
 #include "CntList.h"
 #include "CntDictionary.h"
 #include "CntSet.h"
+#include "CntFlatSet.h"
+#include "CntSparseSet.h"
+#include "CntBitSet.h"
 #include "CntQueue.h"
 #include "CntPriQueue.h"
+#include "CntSpscQueue.h"
+#include "CntMpmcQueue.h"
+#include "CntConcurrentDictionary.h"
 
 #include "CntArray.inl"
+#include "CntInlineArray.inl"
+#include "CntStableArray.inl"
 #include "CntList.inl"
 #include "CntDictionary.inl"
 #include "CntSet.inl"
+#include "CntFlatSet.inl"
+#include "CntSparseSet.inl"
+#include "CntBitSet.inl"
 #include "CntQueue.inl"
 #include "CntPriQueue.inl"
+#include "CntSpscQueue.inl"
+#include "CntMpmcQueue.inl"
+#include "CntConcurrentDictionary.inl"
@@ -13,8 +13,10 @@
 #include "CoreTypes.h"
 
 #include "Memory\Memory.h"
+#include "Memory\MemTrack.h"
 #include "Debug\Debug.h"
 #include "Math\Math.h"
+#include "Memory\MemArena.h"
 #include "Containers\Containers.h"
 #include "String\String.h"
 #include "Pointer\Pointer.h"
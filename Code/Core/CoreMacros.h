@@ -132,6 +132,17 @@ inline void ref(const T &... ) {}
 
 
 
+//*****************************************************************************
+//
+// CACHE_LINE_SIZE - separate data written by different threads by at least
+// this many bytes to avoid false sharing
+//
+//*****************************************************************************
+
+#define CACHE_LINE_SIZE 64
+
+
+
 //*****************************************************************************
 //
 // CLASS_NO_COPY
@@ -63,6 +63,18 @@
 
 
 
+//*****************************************************************************
+//
+// Instruction Sets
+//
+//*****************************************************************************
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define SIMD_SSE2
+#endif
+
+
+
 //*****************************************************************************
 //
 // Build
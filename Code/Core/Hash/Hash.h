@@ -17,7 +17,8 @@ public: // Construction
     Hash32 (const uint8 * start, const uint8 * end);
 
     template <typename T>
-    Hash32 (const T & pod)
+    Hash32 (const T & pod) :
+        Hash32()
     {
         Add(pod);
     }
@@ -47,4 +48,26 @@ private: // Simple Type
     SIMPLE_TYPE_DATA(uint32, m_value);
     SIMPLE_TYPE_EQUATABLE(Hash32);
     SIMPLE_TYPE_COMPARABLE(Hash32);
-};
\ No newline at end of file
+};
+
+
+
+//*****************************************************************************
+//
+// THash
+//
+// Default key hash for the hashed containers. Hashes the bytes of the key, so
+// specialize it for keys whose equality is not bitwise.
+//
+//*****************************************************************************
+
+template <typename T>
+struct THash
+{
+    uint32 operator() (const T & key) const
+    {
+        Hash32 hash;
+        hash.Add(key);
+        return hash.GetHash();
+    }
+};
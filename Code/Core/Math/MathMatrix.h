@@ -237,7 +237,7 @@ public: // Data
 //
 //*****************************************************************************
 
-class Matrix44
+class alignas(16) Matrix44
 {
 public: // Construction
 
@@ -88,6 +88,9 @@ inline uint BitCount (uint32 n);
 inline uint BitCount (uint64 n);
 inline uint BitCount (uintptr_t n);
 
+inline uint LowestBitIndex (uint32 n);  // n must be non-zero
+inline uint LowestBitIndex (uint64 n);
+
 template <typename T>
 inline bool IsInRange (const T & x, const T & a, const T & b);
 
@@ -100,6 +103,9 @@ inline T MapClamp (const T & inMin, const T & inMax, const T & outMin, const T &
 template <typename T>
 inline bool IsPowerTwo (T value);
 
+template <typename T>
+inline T NextPowerTwo (T value);
+
 template <typename T>
 inline bool IsFinite (T value);
 
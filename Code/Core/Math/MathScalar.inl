@@ -1,6 +1,10 @@
 #include "Basics/Meta.h"
 #include "Core/Debug/Debug.h"
 
+#ifdef COMPILER_MSVC
+#   include <intrin.h>
+#endif
+
 //=============================================================================
 template <typename T>
 T Sign (const T & x)
@@ -259,6 +263,45 @@ uint BitCount (uint64_t n)
     return uint(n);
 }
 
+//=============================================================================
+uint LowestBitIndex (uint32 n)
+{
+    ASSERT(n);
+
+#if defined(COMPILER_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, n);
+    return uint(index);
+#elif defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    return uint(__builtin_ctz(n));
+#else
+    uint index = 0;
+    while (!(n & 1))
+    {
+        n >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+//=============================================================================
+uint LowestBitIndex (uint64 n)
+{
+    ASSERT(n);
+
+#if defined(COMPILER_MSVC) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, n);
+    return uint(index);
+#elif defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    return uint(__builtin_ctzll(n));
+#else
+    const uint32 low = uint32(n);
+    return low ? LowestBitIndex(low) : 32 + LowestBitIndex(uint32(n >> 32));
+#endif
+}
+
 //=============================================================================
 template <typename T>
 bool IsInRange (const T & x, const T & a, const T & b)
@@ -289,6 +332,21 @@ bool IsPowerTwo (T value)
     return value != 0 && (value & (value - 1)) == 0;
 }
 
+//=============================================================================
+template <typename T>
+T NextPowerTwo (T value)
+{
+    static_assert(std::numeric_limits<T>::is_integer && !std::numeric_limits<T>::is_signed, "Must be unsigned integral type");
+
+    if (value <= 1)
+        return 1;
+
+    value--;
+    for (uint shift = 1; shift < std::numeric_limits<T>::digits; shift <<= 1)
+        value |= value >> shift;
+    return value + 1;
+}
+
 //=============================================================================
 template <typename T>
 bool IsFinite (T value)
@@ -110,7 +110,7 @@ public: // Data
 //
 //*****************************************************************************
 
-class Vector4
+class alignas(16) Vector4
 {
 public: // Construction
 
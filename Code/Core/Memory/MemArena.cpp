@@ -0,0 +1,133 @@
+#include "Ferrite.h"
+
+#include <atomic>
+
+//*****************************************************************************
+//
+// CLinearArena
+//
+//*****************************************************************************
+
+//=============================================================================
+CLinearArena::CLinearArena (uint blockBytes) :
+    m_block(null),
+    m_ptr(null),
+    m_term(null),
+    m_blockBytes(blockBytes),
+    m_usedInOlder(0)
+{
+}
+
+//=============================================================================
+CLinearArena::~CLinearArena ()
+{
+    for (Block * prev; m_block; m_block = prev)
+    {
+        prev = m_block->prev;
+        ::operator delete(m_block);
+    }
+}
+
+//=============================================================================
+void CLinearArena::Reset ()
+{
+    if (!m_block)
+        return;
+
+    // A frame that spilled into several blocks gets one block big enough for
+    // all of it next time
+    if (m_block->prev)
+    {
+        const uint needed = m_usedInOlder + uint(m_ptr - m_block->Data());
+        for (Block * prev; m_block; m_block = prev)
+        {
+            prev = m_block->prev;
+            ::operator delete(m_block);
+        }
+
+        m_blockBytes = Max(m_blockBytes, Math::NextPowerTwo(needed));
+        PushBlock(m_blockBytes);
+    }
+
+    m_ptr         = m_block->Data();
+    m_term        = m_ptr + m_block->bytes;
+    m_usedInOlder = 0;
+}
+
+//=============================================================================
+uint CLinearArena::BytesUsed () const
+{
+    return m_block ? m_usedInOlder + uint(m_ptr - m_block->Data()) : 0;
+}
+
+//=============================================================================
+uint CLinearArena::BytesReserved () const
+{
+    uint bytes = 0;
+    for (const Block * block = m_block; block; block = block->prev)
+        bytes += block->bytes;
+    return bytes;
+}
+
+//=============================================================================
+void * CLinearArena::AllocSlow (uint bytes, uint align)
+{
+    if (m_block)
+        m_usedInOlder += uint(m_ptr - m_block->Data());
+
+    PushBlock(Max(m_blockBytes, bytes + align));
+    return Alloc(bytes, align);
+}
+
+//=============================================================================
+void CLinearArena::PushBlock (uint minBytes)
+{
+    Block * block = (Block *)::operator new(sizeof(Block) + minBytes);
+    block->prev  = m_block;
+    block->bytes = minBytes;
+
+    m_block = block;
+    m_ptr   = block->Data();
+    m_term  = m_ptr + minBytes;
+}
+
+
+
+//*****************************************************************************
+//
+// Frame arenas
+//
+//*****************************************************************************
+
+//=============================================================================
+static thread_local CLinearArena s_frameArena;
+static thread_local uint64       s_frameSynced = 0;    // s_frameIndex as of the last reset
+
+static std::atomic<uint64>       s_frameIndex(0);
+
+//=============================================================================
+CLinearArena & MemFrameArena ()
+{
+    return s_frameArena;
+}
+
+//=============================================================================
+void MemFrameReset ()
+{
+    s_frameArena.Reset();
+    s_frameSynced = s_frameIndex.load(std::memory_order_relaxed);
+}
+
+//=============================================================================
+void MemFrameAdvance ()
+{
+    s_frameIndex.fetch_add(1, std::memory_order_relaxed);
+    MemFrameReset();
+}
+
+//=============================================================================
+void MemFrameSync ()
+{
+    if (s_frameSynced != s_frameIndex.load(std::memory_order_relaxed))
+        MemFrameReset();
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+//*****************************************************************************
+//
+// CLinearArena
+//
+// Bump allocator for short lived data. Alloc advances a pointer through the
+// current block and Reset releases everything at once; individual frees are
+// not supported. When a frame overflows the first block, further blocks are
+// chained on, and the next Reset coalesces them into a single block large
+// enough for the whole frame so steady state needs no chaining.
+//
+// Not thread safe. Each thread uses its own arena.
+//
+//*****************************************************************************
+
+class CLinearArena
+{
+public:
+    explicit CLinearArena (uint blockBytes = DEFAULT_BLOCK_BYTES);
+    ~CLinearArena ();
+
+    inline void * Alloc (uint bytes, uint align = alignof(std::max_align_t));
+
+    template <typename T>
+    inline T * Alloc (uint count);
+
+    void Reset ();
+
+    uint BytesUsed () const;
+    uint BytesReserved () const;
+
+    static const uint DEFAULT_BLOCK_BYTES = 64 * 1024;
+
+private:
+    CLASS_NO_COPY(CLinearArena);
+
+    struct Block
+    {
+        Block * prev;
+        uint    bytes;
+
+        byte * Data () { return (byte *)(this + 1); }
+    };
+
+    Block * m_block;        // Current block, older blocks chain through prev
+    byte *  m_ptr;
+    byte *  m_term;
+    uint    m_blockBytes;
+    uint    m_usedInOlder;  // Bytes used in blocks before the current one
+
+    void * AllocSlow (uint bytes, uint align);
+    void   PushBlock (uint minBytes);
+};
+
+
+
+//*****************************************************************************
+//
+// Frame arenas
+//
+// MemFrameArena returns an arena owned by the calling thread. Nothing it
+// hands out may outlive the frame it was allocated in.
+//
+// Time::Update calls MemFrameAdvance, which starts a new frame and resets the
+// calling thread's arena. Other threads catch up with MemFrameSync, which
+// resets their arena if a frame has started since they last did; job workers
+// call it between jobs, and Job::CTaskGraph::Run calls it for the thread that
+// runs the graph. A thread must hold no frame temporaries when it calls
+// either.
+//
+//*****************************************************************************
+
+CLinearArena & MemFrameArena ();
+void           MemFrameReset ();     // Resets the calling thread's arena now
+void           MemFrameAdvance ();
+void           MemFrameSync ();
+
+
+
+//*****************************************************************************
+//
+// TArenaAllocator
+//
+// Standard allocator over a CLinearArena, the calling thread's frame arena by
+// default. Deallocation is a no-op.
+//
+//*****************************************************************************
+
+template <typename T>
+class TArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    inline TArenaAllocator ();
+    inline explicit TArenaAllocator (CLinearArena * arena);
+
+    template <typename U>
+    inline TArenaAllocator (const TArenaAllocator<U> & rhs);
+
+    inline T *  allocate (size_t count);
+    inline void deallocate (T * ptr, size_t count);
+
+    CLinearArena * GetArena () const { return m_arena; }
+
+    template <typename U>
+    bool operator== (const TArenaAllocator<U> & rhs) const { return m_arena == rhs.GetArena(); }
+    template <typename U>
+    bool operator!= (const TArenaAllocator<U> & rhs) const { return m_arena != rhs.GetArena(); }
+
+private:
+    CLinearArena * m_arena;
+};
+
+#include "MemArena.inl"
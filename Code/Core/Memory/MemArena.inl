@@ -0,0 +1,75 @@
+
+//*****************************************************************************
+//
+// CLinearArena
+//
+//*****************************************************************************
+
+//=============================================================================
+void * CLinearArena::Alloc (uint bytes, uint align)
+{
+    ASSERT(Math::IsPowerTwo(align));
+
+    if (!m_ptr)
+        return AllocSlow(bytes, align);
+
+    byte * ptr = (byte *)(((uintptr_t)m_ptr + (align - 1)) & ~(uintptr_t)(align - 1));
+    if (ptr + bytes > m_term)
+        return AllocSlow(bytes, align);
+
+    m_ptr = ptr + bytes;
+    return ptr;
+}
+
+//=============================================================================
+template <typename T>
+T * CLinearArena::Alloc (uint count)
+{
+    return (T *)Alloc(sizeof(T) * count, alignof(T));
+}
+
+
+
+//*****************************************************************************
+//
+// TArenaAllocator
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T>
+TArenaAllocator<T>::TArenaAllocator () :
+    m_arena(&MemFrameArena())
+{
+}
+
+//=============================================================================
+template <typename T>
+TArenaAllocator<T>::TArenaAllocator (CLinearArena * arena) :
+    m_arena(arena)
+{
+    ASSERT(arena);
+}
+
+//=============================================================================
+template <typename T>
+template <typename U>
+TArenaAllocator<T>::TArenaAllocator (const TArenaAllocator<U> & rhs) :
+    m_arena(rhs.GetArena())
+{
+}
+
+//=============================================================================
+template <typename T>
+T * TArenaAllocator<T>::allocate (size_t count)
+{
+    return m_arena->Alloc<T>(uint(count));
+}
+
+//=============================================================================
+template <typename T>
+void TArenaAllocator<T>::deallocate (T * ptr, size_t count)
+{
+    // Memory is reclaimed when the arena resets
+    ref(ptr, count);
+}
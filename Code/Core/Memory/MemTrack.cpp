@@ -0,0 +1,278 @@
+#include "Ferrite.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(MEMORY_TRACKING) && defined(PLATFORM_WINDOWS)
+#   include <Windows.h>
+#endif
+
+//*****************************************************************************
+//
+// Memory tags
+//
+//*****************************************************************************
+
+//=============================================================================
+static const char * s_tagNames[] =
+{
+    "Untagged",
+    "Physics",
+    "Pathing",
+    "Json",
+    "Net",
+    "UI",
+    "Graphics",
+};
+static_assert(array_size(s_tagNames) == (uint)EMemTag::Count, "Tag name missing");
+
+//=============================================================================
+const char * MemTagName (EMemTag tag)
+{
+    ASSERT(tag < EMemTag::Count);
+    return s_tagNames[(uint)tag];
+}
+
+
+
+#ifdef MEMORY_TRACKING
+
+//*****************************************************************************
+//
+// Tracking state
+//
+//*****************************************************************************
+
+namespace
+{
+
+// Padded so threads charging different tags do not share a cache line
+struct alignas(CACHE_LINE_SIZE) TagStats
+{
+    std::atomic<uint64> liveBytes;
+    std::atomic<uint64> peakBytes;
+    std::atomic<uint64> liveCount;
+    std::atomic<uint64> totalCount;
+    std::atomic<uint64> budgetBytes;
+    std::atomic<bool>   budgetAssert;
+    std::atomic<bool>   overBudget;
+};
+
+// Prefixed to every allocation so the free can be charged back to the tag
+// that made it. Padded to keep the user pointer maximally aligned.
+struct alignas(std::max_align_t) Header
+{
+    uint64  bytes;
+    EMemTag tag;
+};
+
+} // namespace
+
+//=============================================================================
+static TagStats s_stats[(uint)EMemTag::Count];
+static thread_local EMemTag s_currentTag = EMemTag::Untagged;
+
+//=============================================================================
+static void DebugOutput (const char text[])
+{
+#ifdef PLATFORM_WINDOWS
+    OutputDebugStringA(text);
+#else
+    fputs(text, stderr);
+#endif
+}
+
+//=============================================================================
+static void OnOverBudget (EMemTag tag, uint64 liveBytes, uint64 budgetBytes)
+{
+    TagStats & stats = s_stats[(uint)tag];
+
+    // Report once per overrun rather than on every allocation
+    if (stats.overBudget.exchange(true, std::memory_order_relaxed))
+        return;
+
+    char text[128];
+    snprintf(
+        text,
+        array_size(text),
+        "Memory budget exceeded: %s using %llu of %llu bytes\n",
+        MemTagName(tag),
+        (unsigned long long)liveBytes,
+        (unsigned long long)budgetBytes
+    );
+    DebugOutput(text);
+
+    if (stats.budgetAssert.load(std::memory_order_relaxed))
+        ASSERT(liveBytes <= budgetBytes);
+}
+
+//=============================================================================
+static void TrackAlloc (EMemTag tag, uint64 bytes)
+{
+    TagStats & stats = s_stats[(uint)tag];
+
+    const uint64 live = stats.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    stats.liveCount.fetch_add(1, std::memory_order_relaxed);
+    stats.totalCount.fetch_add(1, std::memory_order_relaxed);
+
+    uint64 peak = stats.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !stats.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+
+    const uint64 budget = stats.budgetBytes.load(std::memory_order_relaxed);
+    if (budget && live > budget)
+        OnOverBudget(tag, live, budget);
+}
+
+//=============================================================================
+static void TrackFree (EMemTag tag, uint64 bytes)
+{
+    TagStats & stats = s_stats[(uint)tag];
+
+    const uint64 live = stats.liveBytes.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+    stats.liveCount.fetch_sub(1, std::memory_order_relaxed);
+
+    if (stats.overBudget.load(std::memory_order_relaxed) && live <= stats.budgetBytes.load(std::memory_order_relaxed))
+        stats.overBudget.store(false, std::memory_order_relaxed);
+}
+
+
+
+//*****************************************************************************
+//
+// Global allocation hook
+//
+// The standard library's default nothrow, array and sized forms all forward
+// to these two, so they are the only ones replaced. Over-aligned allocations
+// go through the separate align_val_t forms and are not tracked.
+//
+//*****************************************************************************
+
+//=============================================================================
+void * operator new (size_t bytes)
+{
+    Header * header = (Header *)malloc(sizeof(Header) + bytes);
+    if (!header)
+        throw std::bad_alloc();
+
+    header->bytes = bytes;
+    header->tag   = s_currentTag;
+    TrackAlloc(header->tag, bytes);
+
+    return header + 1;
+}
+
+//=============================================================================
+void operator delete (void * ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    Header * header = (Header *)ptr - 1;
+    TrackFree(header->tag, header->bytes);
+    free(header);
+}
+
+//=============================================================================
+void operator delete (void * ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+
+
+//*****************************************************************************
+//
+// CMemTagScope
+//
+//*****************************************************************************
+
+//=============================================================================
+CMemTagScope::CMemTagScope (EMemTag tag) :
+    m_prev(s_currentTag)
+{
+    ASSERT(tag < EMemTag::Count);
+    s_currentTag = tag;
+}
+
+//=============================================================================
+CMemTagScope::~CMemTagScope ()
+{
+    s_currentTag = m_prev;
+}
+
+
+
+//*****************************************************************************
+//
+// Tracking API
+//
+//*****************************************************************************
+
+//=============================================================================
+EMemTag MemTagCurrent ()
+{
+    return s_currentTag;
+}
+
+//=============================================================================
+void MemTagSetBudget (EMemTag tag, uint64 bytes, EMemBudget action)
+{
+    ASSERT(tag < EMemTag::Count);
+    TagStats & stats = s_stats[(uint)tag];
+
+    stats.budgetAssert.store(action == EMemBudget::Assert, std::memory_order_relaxed);
+    stats.budgetBytes.store(bytes, std::memory_order_relaxed);
+    stats.overBudget.store(false, std::memory_order_relaxed);
+}
+
+//=============================================================================
+MemTagStats MemTagGetStats (EMemTag tag)
+{
+    ASSERT(tag < EMemTag::Count);
+    const TagStats & stats = s_stats[(uint)tag];
+
+    MemTagStats out;
+    out.liveBytes   = stats.liveBytes.load(std::memory_order_relaxed);
+    out.peakBytes   = stats.peakBytes.load(std::memory_order_relaxed);
+    out.liveCount   = stats.liveCount.load(std::memory_order_relaxed);
+    out.totalCount  = stats.totalCount.load(std::memory_order_relaxed);
+    out.budgetBytes = stats.budgetBytes.load(std::memory_order_relaxed);
+    return out;
+}
+
+//=============================================================================
+void MemTagResetPeaks ()
+{
+    for (TagStats & stats : s_stats)
+        stats.peakBytes.store(stats.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+//=============================================================================
+void MemTrackDump ()
+{
+    char text[160];
+
+    DebugOutput("Memory tag          live bytes    peak bytes    live allocs   total allocs  budget\n");
+    for (uint i = 0; i < (uint)EMemTag::Count; ++i)
+    {
+        const MemTagStats stats = MemTagGetStats(EMemTag(i));
+        snprintf(
+            text,
+            array_size(text),
+            "%-18s  %12llu  %12llu  %12llu  %12llu  %llu%s\n",
+            MemTagName(EMemTag(i)),
+            (unsigned long long)stats.liveBytes,
+            (unsigned long long)stats.peakBytes,
+            (unsigned long long)stats.liveCount,
+            (unsigned long long)stats.totalCount,
+            (unsigned long long)stats.budgetBytes,
+            stats.budgetBytes && stats.liveBytes > stats.budgetBytes ? "  OVER" : ""
+        );
+        DebugOutput(text);
+    }
+}
+
+#endif // MEMORY_TRACKING
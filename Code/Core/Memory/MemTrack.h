@@ -0,0 +1,116 @@
+#pragma once
+
+#ifdef BUILD_DEBUG
+#   define MEMORY_TRACKING
+#endif
+
+//*****************************************************************************
+//
+// Memory tags
+//
+// Every heap allocation is charged to the tag that is current on the
+// allocating thread. Systems mark their entry points with MEM_TAG_SCOPE and
+// anything allocated underneath, including by containers and utilities they
+// call into, is charged to them:
+//
+//      void CContext::Update (Time::Delta deltaTime)
+//      {
+//          MEM_TAG_SCOPE(Physics);
+//          ...
+//      }
+//
+// Frees are charged back to the tag that made the allocation, whichever scope
+// the free happens in.
+//
+// Tracking replaces the global operator new and delete and is only compiled
+// in when MEMORY_TRACKING is defined. Otherwise scopes expand to nothing and
+// the query functions below report zeroes.
+//
+//*****************************************************************************
+
+enum class EMemTag : uint8
+{
+    Untagged,
+    Physics,
+    Pathing,
+    Json,
+    Net,
+    UI,
+    Graphics,
+
+    Count
+};
+
+const char * MemTagName (EMemTag tag);
+
+
+
+//*****************************************************************************
+//
+// Budgets
+//
+// A tag whose live bytes climb past its budget either reports the overrun
+// once through the debug output, or asserts. The report is re-armed when the
+// tag drops back under budget. A budget of zero means unlimited.
+//
+//*****************************************************************************
+
+enum class EMemBudget
+{
+    Warn,
+    Assert,
+};
+
+struct MemTagStats
+{
+    uint64 liveBytes;
+    uint64 peakBytes;
+    uint64 liveCount;   // Allocations not yet freed
+    uint64 totalCount;  // Allocations ever made
+    uint64 budgetBytes;
+};
+
+
+
+//*****************************************************************************
+//
+// Tracking API
+//
+//*****************************************************************************
+
+#ifdef MEMORY_TRACKING
+
+class CMemTagScope
+{
+public:
+    explicit CMemTagScope (EMemTag tag);
+    ~CMemTagScope ();
+
+private:
+    CLASS_NO_COPY(CMemTagScope);
+
+    EMemTag m_prev;
+};
+
+#   define MEM_TAG_SCOPE(tag) CMemTagScope UNIQUE_SYMBOL(memTagScope)(EMemTag::tag)
+
+EMemTag     MemTagCurrent ();
+void        MemTagSetBudget (EMemTag tag, uint64 bytes, EMemBudget action = EMemBudget::Warn);
+MemTagStats MemTagGetStats (EMemTag tag);
+void        MemTagResetPeaks ();
+
+// Writes a table of every tag's stats to the debug output. Cheap enough to
+// bind to a debug key; also worth calling at shutdown to spot leaks.
+void        MemTrackDump ();
+
+#else
+
+#   define MEM_TAG_SCOPE(tag)
+
+inline EMemTag     MemTagCurrent () { return EMemTag::Untagged; }
+inline void        MemTagSetBudget (EMemTag, uint64, EMemBudget = EMemBudget::Warn) {}
+inline MemTagStats MemTagGetStats (EMemTag) { return MemTagStats(); }
+inline void        MemTagResetPeaks () {}
+inline void        MemTrackDump () {}
+
+#endif
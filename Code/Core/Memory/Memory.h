@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstddef>
+
+#ifdef SIMD_SSE2
+#   include <emmintrin.h>
+#endif
+
 //*****************************************************************************
 //
 // Endian
@@ -15,6 +21,64 @@ enum class EEndian
 
 
 
+//*****************************************************************************
+//
+// MemAllocAligned
+//
+// Allocates with at least the requested power of two alignment. Alignments up
+// to that of std::max_align_t go straight to operator new; larger ones
+// over-allocate and keep the original pointer just before the returned one.
+// The same alignment must be passed to MemFreeAligned.
+//
+//*****************************************************************************
+
+inline void * MemAllocAligned (uint bytes, uint align);
+inline void   MemFreeAligned (void * ptr, uint align);
+
+
+
+//*****************************************************************************
+//
+// TAlignedAllocator
+//
+// Standard allocator honouring alignof(T), or a larger explicit Align. The
+// default allocator of TArray, so that over-aligned math types can be loaded
+// with aligned SIMD instructions straight out of any array.
+//
+//*****************************************************************************
+
+template <typename T, uint Align = alignof(T)>
+class TAlignedAllocator
+{
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef TAlignedAllocator<U, (Align > alignof(U) ? Align : alignof(U))> other;
+    };
+
+    TAlignedAllocator () {}
+
+    template <typename U, uint B>
+    TAlignedAllocator (const TAlignedAllocator<U, B> &) {}
+
+    inline T *  allocate (size_t count);
+    inline void deallocate (T * ptr, size_t count);
+
+    template <typename U, uint B>
+    bool operator== (const TAlignedAllocator<U, B> &) const { return true; }
+    template <typename U, uint B>
+    bool operator!= (const TAlignedAllocator<U, B> &) const { return false; }
+
+private:
+    static_assert(Align >= alignof(T), "Cannot align below the natural alignment of T");
+    static_assert((Align & (Align - 1)) == 0, "Alignment must be a power of two");
+};
+
+
+
 //*****************************************************************************
 //
 // MemSet
@@ -23,6 +87,15 @@ enum class EEndian
 
 inline void MemSet (void * ptr, uint bytes, byte value); 
 
+// Fixed size set, for sizes known at compile time
+template <uint N>
+inline void MemSet (void * ptr, byte value);
+
+// Sets a large buffer with non-temporal stores that bypass the cache, for
+// buffers such as framebuffers that will not be read again soon. Any
+// alignment is accepted but a 16 byte aligned ptr avoids a partial head.
+inline void MemSetStream (void * ptr, uint bytes, byte value);
+
 
 
 //*****************************************************************************
@@ -39,6 +112,17 @@ inline void MemCopy (T & destination, const T & source);
 template <typename T>
 inline void MemCopy (T *& destination, const T *& source);
 
+// Fixed size copy, for sizes known at compile time
+template <uint N>
+inline void MemCopy (void * destination, const void * source);
+
+// Both pointers must be 16 byte aligned; the aligned loads fault otherwise.
+// Any bytes past the last whole 16 byte block are copied separately.
+inline void MemCopyAligned (void * destination, const void * source, uint bytes);
+
+// Copies a large buffer with non-temporal stores, see MemSetStream
+inline void MemCopyStream (void * destination, const void * source, uint bytes);
+
 
 //template <typename T, uint N>
 //inline void MemCopy (T (& destination)[N], const T (& source)[N]);
@@ -49,8 +133,13 @@ inline void MemCopy (T *& destination, const T *& source);
 //
 //*****************************************************************************
 
+// Compares 32 bytes per step and returns at the first step that differs
 inline bool MemEqual (const void * a, const void * b, uint bytes);
 
+// Fixed size compare, for sizes known at compile time
+template <uint N>
+inline bool MemEqual (const void * a, const void * b);
+
 
 
 //*****************************************************************************
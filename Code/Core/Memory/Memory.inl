@@ -1,4 +1,61 @@
 
+//*****************************************************************************
+//
+// MemAllocAligned
+//
+//*****************************************************************************
+
+//=============================================================================
+void * MemAllocAligned (uint bytes, uint align)
+{
+    if (align <= alignof(std::max_align_t))
+        return ::operator new(bytes);
+
+    // The gap below the aligned pointer is at least max_align_t bytes, which
+    // always leaves room to stash the original pointer
+    byte * raw = (byte *)::operator new(bytes + align);
+    byte * ptr = (byte *)(((uintptr_t)raw + align) & ~(uintptr_t)(align - 1));
+    ((void **)ptr)[-1] = raw;
+    return ptr;
+}
+
+//=============================================================================
+void MemFreeAligned (void * ptr, uint align)
+{
+    if (!ptr)
+        return;
+
+    if (align <= alignof(std::max_align_t))
+        ::operator delete(ptr);
+    else
+        ::operator delete(((void **)ptr)[-1]);
+}
+
+
+
+//*****************************************************************************
+//
+// TAlignedAllocator
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, uint Align>
+T * TAlignedAllocator<T, Align>::allocate (size_t count)
+{
+    return (T *)MemAllocAligned(uint(sizeof(T) * count), Align);
+}
+
+//=============================================================================
+template <typename T, uint Align>
+void TAlignedAllocator<T, Align>::deallocate (T * ptr, size_t count)
+{
+    ref(count);
+    MemFreeAligned(ptr, Align);
+}
+
+
+
 
 
 //*****************************************************************************
@@ -13,6 +70,46 @@ void MemSet (void * ptr, uint bytes, byte value)
     memset(ptr, value, bytes);
 }
 
+//=============================================================================
+template <uint N>
+void MemSet (void * ptr, byte value)
+{
+    // A constant length lets the compiler replace the call with stores
+    memset(ptr, value, N);
+}
+
+//=============================================================================
+void MemSetStream (void * ptr, uint bytes, byte value)
+{
+#ifdef SIMD_SSE2
+    byte * dst = (byte *)ptr;
+
+    // Plain stores up to the first 16 byte boundary
+    uint head = uint(-(uintptr_t)dst & 15);
+    head = (head < bytes) ? head : bytes;
+    memset(dst, value, head);
+    dst   += head;
+    bytes -= head;
+
+    const __m128i fill = _mm_set1_epi8((char)value);
+    for (; bytes >= 64; bytes -= 64, dst += 64)
+    {
+        _mm_stream_si128((__m128i *)dst + 0, fill);
+        _mm_stream_si128((__m128i *)dst + 1, fill);
+        _mm_stream_si128((__m128i *)dst + 2, fill);
+        _mm_stream_si128((__m128i *)dst + 3, fill);
+    }
+    for (; bytes >= 16; bytes -= 16, dst += 16)
+        _mm_stream_si128((__m128i *)dst, fill);
+
+    // Streaming stores are weakly ordered, fence before anyone else looks
+    _mm_sfence();
+    memset(dst, value, bytes);
+#else
+    memset(ptr, value, bytes);
+#endif
+}
+
 
 
 //*****************************************************************************
@@ -32,7 +129,7 @@ template <typename T>
 void MemCopy (T & destination, const T & source)
 {
     static_assert(std::is_pod<T>::value, "must be POD type");
-    MemCopy(&destination, source, sizeof(source));
+    MemCopy<sizeof(T)>(&destination, &source);
 }
 
 //=============================================================================
@@ -43,13 +140,66 @@ void MemCopy (T *& destination, const T *& source)
     MemCopy(destination, source, sizeof(T));
 }
 
-////=============================================================================
-//template <typename T, uint N>
-//inline void MemCopy (T (& destination)[N], const T (& source)[N])
-//{
-//    static_assert(std::is_pod<T>::value, "must be POD type");
-//    MemCopy(&destination, &source, sizeof(T) * N);
-//}
+//=============================================================================
+template <uint N>
+void MemCopy (void * destination, const void * source)
+{
+    // A constant length lets the compiler replace the call with a few
+    // register moves
+    memcpy(destination, source, N);
+}
+
+//=============================================================================
+void MemCopyAligned (void * destination, const void * source, uint bytes)
+{
+#ifdef SIMD_SSE2
+    __m128i *       dst = (__m128i *)destination;
+    const __m128i * src = (const __m128i *)source;
+    for (const __m128i * term = src + bytes / 16; src < term; ++src, ++dst)
+        _mm_store_si128(dst, _mm_load_si128(src));
+
+    memcpy(dst, src, bytes % 16);
+#else
+    memcpy(destination, source, bytes);
+#endif
+}
+
+//=============================================================================
+void MemCopyStream (void * destination, const void * source, uint bytes)
+{
+#ifdef SIMD_SSE2
+    byte *       dst = (byte *)destination;
+    const byte * src = (const byte *)source;
+
+    // Plain copy up to the first 16 byte boundary of the destination; the
+    // source may stay misaligned
+    uint head = uint(-(uintptr_t)dst & 15);
+    head = (head < bytes) ? head : bytes;
+    memcpy(dst, src, head);
+    dst   += head;
+    src   += head;
+    bytes -= head;
+
+    for (; bytes >= 64; bytes -= 64, dst += 64, src += 64)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i *)src + 0);
+        const __m128i b = _mm_loadu_si128((const __m128i *)src + 1);
+        const __m128i c = _mm_loadu_si128((const __m128i *)src + 2);
+        const __m128i d = _mm_loadu_si128((const __m128i *)src + 3);
+        _mm_stream_si128((__m128i *)dst + 0, a);
+        _mm_stream_si128((__m128i *)dst + 1, b);
+        _mm_stream_si128((__m128i *)dst + 2, c);
+        _mm_stream_si128((__m128i *)dst + 3, d);
+    }
+    for (; bytes >= 16; bytes -= 16, dst += 16, src += 16)
+        _mm_stream_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)src));
+
+    _mm_sfence();
+    memcpy(dst, src, bytes);
+#else
+    memcpy(destination, source, bytes);
+#endif
+}
 
 
 //*****************************************************************************
@@ -58,10 +208,84 @@ void MemCopy (T *& destination, const T *& source)
 //
 //*****************************************************************************
 
+//=============================================================================
+#ifdef SIMD_SSE2
+inline bool MemEqual16 (const byte * a, const byte * b)
+{
+    const __m128i eq = _mm_cmpeq_epi8(
+        _mm_loadu_si128((const __m128i *)a),
+        _mm_loadu_si128((const __m128i *)b)
+    );
+    return _mm_movemask_epi8(eq) == 0xffff;
+}
+#endif
+
 //=============================================================================
 bool MemEqual (const void * a, const void * b, uint bytes)
 {
+#ifdef SIMD_SSE2
+    const byte * pa = (const byte *)a;
+    const byte * pb = (const byte *)b;
+
+    if (bytes < 16)
+        return memcmp(pa, pb, bytes) == 0;
+
+    // Both halves are combined so each 32 byte step costs a single branch
+    const byte * term = pa + bytes;
+    for (; term - pa >= 32; pa += 32, pb += 32)
+    {
+        const __m128i eq0 = _mm_cmpeq_epi8(
+            _mm_loadu_si128((const __m128i *)pa),
+            _mm_loadu_si128((const __m128i *)pb)
+        );
+        const __m128i eq1 = _mm_cmpeq_epi8(
+            _mm_loadu_si128((const __m128i *)pa + 1),
+            _mm_loadu_si128((const __m128i *)pb + 1)
+        );
+        if (_mm_movemask_epi8(_mm_and_si128(eq0, eq1)) != 0xffff)
+            return false;
+    }
+
+    if (term - pa >= 16)
+    {
+        if (!MemEqual16(pa, pb))
+            return false;
+        pa += 16;
+        pb += 16;
+    }
+
+    // Finish with a 16 byte compare overlapping bytes already checked
+    if (pa == term)
+        return true;
+
+    const uint tail = uint(term - pa);
+    return MemEqual16(pa + tail - 16, pb + tail - 16);
+#else
     return memcmp(a, b, bytes) == 0;
+#endif
+}
+
+//=============================================================================
+template <uint N>
+bool MemEqual (const void * a, const void * b)
+{
+    // Sizes that fit a register compare as integers; the branches fold away
+    // for any given N
+    if (N == 1 || N == 2 || N == 4 || N == 8)
+    {
+        uint64 va = 0;
+        uint64 vb = 0;
+        memcpy(&va, a, N);
+        memcpy(&vb, b, N);
+        return va == vb;
+    }
+
+#ifdef SIMD_SSE2
+    if (N == 16)
+        return MemEqual16((const byte *)a, (const byte *)b);
+#endif
+
+    return MemEqual(a, b, N);
 }
 
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <thread>
+
 //*****************************************************************************
 //
 // Forwards
@@ -8,12 +11,13 @@
 
 template <typename T> class     TWeakPtr;
 template <typename T> class     TStrongPtr;
-template <typename T> interface IRefCounted;
+template <typename T, bool Atomic = false> interface IRefCounted;
 
 namespace Pointer {
 namespace Private {
     template <typename T> class TSmartPtrBase;
-	template <typename T> class TSmartPtrData;
+	template <typename T, bool Atomic> class TSmartPtrData;
+    class CWeakLock;
 }} // namespace Pointer::Private
 
 
@@ -63,7 +67,7 @@ template <typename T>
 class TStrongPtr :
     public Pointer::Private::TSmartPtrBase<T>
 {
-    template <typename T>
+    template <typename U>
     friend class TWeakPtr;
 public:
 
@@ -93,7 +97,7 @@ template <typename T>
 class TWeakPtr :
     public Pointer::Private::TSmartPtrBase<T>
 {
-    template <typename T>
+    template <typename U, bool Atomic>
     friend class Pointer::Private::TSmartPtrData;
 public:
 
@@ -105,6 +109,11 @@ public:
 
     TWeakPtr<T> & operator= (const TWeakPtr<T> & rhs);
 
+    // Strong reference to the object, or null if it is gone or going. The
+    // only safe way to use a weak pointer to a thread-safe object that other
+    // threads may release.
+    TStrongPtr<T> Lock () const;
+
 private:
     void OnObjectDestroyed ();
 
@@ -117,18 +126,58 @@ private:
 //
 // IRefCounted
 //
+// Atomic selects the thread-safe mode: reference counts change atomically and
+// weak pointers are tracked under a lock, so strong and weak pointers to one
+// object may be copied and dropped on any thread. Objects that never leave
+// one thread can keep the default, whose counts are plain increments.
+//
+//      interface IEntity : IRefCounted<IEntity, true>
+//
 //*****************************************************************************
 
-template <typename T>
+template <typename T, bool Atomic>
 interface IRefCounted
 {
+    static const bool REFCOUNT_ATOMIC = Atomic;
+
 	virtual void IncRef () pure;
+	virtual bool TryIncRef () pure;    // Fails once the count has reached zero
 	virtual unsigned DecRef () pure;
 	virtual void AddWeakRef (TWeakPtr<T> * weak) pure;
 };
 
 
 
+//*****************************************************************************
+//
+// CWeakLock
+//
+// Guards weak pointer bookkeeping for thread-safe objects. Weak pointers are
+// made and dropped far less often than strong references change, so a single
+// lock shared by every object is enough. Does nothing when not enabled.
+//
+//*****************************************************************************
+
+namespace Pointer { namespace Private {
+
+class CWeakLock
+{
+public:
+    explicit CWeakLock (bool enabled);
+    ~CWeakLock ();
+
+private:
+    CLASS_NO_COPY(CWeakLock);
+
+    static std::atomic<bool> & Locked ();
+
+    bool m_enabled;
+};
+
+}} // namespace Pointer::Private
+
+
+
 //*****************************************************************************
 //
 // TSmartPtrData
@@ -136,7 +185,7 @@ interface IRefCounted
 //*****************************************************************************
 namespace Pointer { namespace Private {
 
-template <typename T>
+template <typename T, bool Atomic>
 class TSmartPtrData
 {
 public:
@@ -145,16 +194,23 @@ public:
     ~TSmartPtrData ();
 
     void IncRef ();
+    bool TryIncRef ();
     uint DecRef ();
+
+    // Caller holds the weak lock
     void AddWeakRef (TWeakPtr<T> * weak);
 
+    // Nulls every weak pointer; called once the count reaches zero, before
+    // the object starts to destroy itself
+    void DetachWeakRefs ();
+
 private:
     // Types
     typedef LIST_DECLARE(TWeakPtr<T>, m_link) WeakList;
 
     // Data
-    WeakList m_weaklist;
-    uint     m_refCount;
+    WeakList          m_weaklist;
+    std::atomic<uint> m_refCount;   // Plain loads and stores unless Atomic
 };
 
 }} // namespace Pointer::Private
@@ -170,16 +226,22 @@ private:
 	private:													\
     friend class TWeakPtr<interface>;                           \
     friend class TStrongPtr<interface>;                         \
-	Pointer::Private::TSmartPtrData<interface> m_smartPtrData;	\
+	Pointer::Private::TSmartPtrData<interface, interface::REFCOUNT_ATOMIC> m_smartPtrData; \
 																\
 	void IncRef () override {									\
 		m_smartPtrData.IncRef();								\
 	}															\
 																\
+	bool TryIncRef () override {								\
+		return m_smartPtrData.TryIncRef();						\
+	}															\
+																\
 	uint DecRef () override {									\
 		const uint count = m_smartPtrData.DecRef();				\
-		if (count == 0)											\
+		if (count == 0) {										\
+			m_smartPtrData.DetachWeakRefs();					\
 			delete this;										\
+		}														\
 		return count;											\
 	}															\
 																\
@@ -174,9 +174,12 @@ TWeakPtr<T>::TWeakPtr ()
 
 //=============================================================================
 template <typename T>
-TWeakPtr<T>::TWeakPtr (const TWeakPtr<T> & rhs) :
-    Pointer::Private::TSmartPtrBase<T>(rhs.m_ptr)
+TWeakPtr<T>::TWeakPtr (const TWeakPtr<T> & rhs)
 {
+    // rhs may be detached by another thread until the lock is held
+    Pointer::Private::CWeakLock lock(T::REFCOUNT_ATOMIC);
+
+    m_ptr = rhs.m_ptr;
     if (m_ptr)
         m_ptr->AddWeakRef(this);
 }
@@ -186,6 +189,8 @@ template <typename T>
 TWeakPtr<T>::TWeakPtr (const TStrongPtr<T> & rhs) :
     Pointer::Private::TSmartPtrBase<T>(rhs.m_ptr)
 {
+    Pointer::Private::CWeakLock lock(T::REFCOUNT_ATOMIC);
+
     if (m_ptr)
         m_ptr->AddWeakRef(this);
 }
@@ -195,6 +200,8 @@ template <typename T>
 TWeakPtr<T>::TWeakPtr (T * data) :
     Pointer::Private::TSmartPtrBase<T>(data)
 {
+    Pointer::Private::CWeakLock lock(T::REFCOUNT_ATOMIC);
+
     if (m_ptr)
         m_ptr->AddWeakRef(this);
 }
@@ -203,6 +210,9 @@ TWeakPtr<T>::TWeakPtr (T * data) :
 template <typename T>
 TWeakPtr<T>::~TWeakPtr ()
 {
+    Pointer::Private::CWeakLock lock(T::REFCOUNT_ATOMIC);
+
+    m_link.Unlink();
     m_ptr = null;
 }
 
@@ -210,6 +220,8 @@ TWeakPtr<T>::~TWeakPtr ()
 template <typename T>
 TWeakPtr<T> & TWeakPtr<T>::operator= (const TWeakPtr<T> & rhs)
 {
+    Pointer::Private::CWeakLock lock(T::REFCOUNT_ATOMIC);
+
     m_link.Unlink();
 
     m_ptr = rhs.m_ptr;
@@ -220,6 +232,27 @@ TWeakPtr<T> & TWeakPtr<T>::operator= (const TWeakPtr<T> & rhs)
     return *this;
 }
 
+//=============================================================================
+template <typename T>
+TStrongPtr<T> TWeakPtr<T>::Lock () const
+{
+    T * ptr;
+    {
+        // While attached the object has not started to destroy itself, but
+        // its count may already be zero
+        Pointer::Private::CWeakLock lock(T::REFCOUNT_ATOMIC);
+
+        ptr = m_ptr;
+        if (!ptr || !ptr->TryIncRef())
+            return TStrongPtr<T>();
+    }
+
+    // Swap the reference taken above for the strong pointer's own
+    TStrongPtr<T> strong(ptr);
+    ptr->DecRef();
+    return strong;
+}
+
 //=============================================================================
 template <typename T>
 void TWeakPtr<T>::OnObjectDestroyed ()
@@ -229,6 +262,47 @@ void TWeakPtr<T>::OnObjectDestroyed ()
 
 
 
+//*****************************************************************************
+//
+// CWeakLock
+//
+//*****************************************************************************
+
+namespace Pointer { namespace Private {
+
+//=============================================================================
+inline CWeakLock::CWeakLock (bool enabled) :
+    m_enabled(enabled)
+{
+    if (!m_enabled)
+        return;
+
+    std::atomic<bool> & locked = Locked();
+    while (locked.exchange(true, std::memory_order_acquire))
+    {
+        while (locked.load(std::memory_order_relaxed))
+            std::this_thread::yield();
+    }
+}
+
+//=============================================================================
+inline CWeakLock::~CWeakLock ()
+{
+    if (m_enabled)
+        Locked().store(false, std::memory_order_release);
+}
+
+//=============================================================================
+inline std::atomic<bool> & CWeakLock::Locked ()
+{
+    static std::atomic<bool> s_locked(false);
+    return s_locked;
+}
+
+}} // namespace Pointer::Private
+
+
+
 //*****************************************************************************
 //
 // TSmartPtrData
@@ -238,42 +312,89 @@ void TWeakPtr<T>::OnObjectDestroyed ()
 namespace Pointer { namespace Private {
 
 //=============================================================================
-template <typename T>
-TSmartPtrData<T>::TSmartPtrData () :
+template <typename T, bool Atomic>
+TSmartPtrData<T, Atomic>::TSmartPtrData () :
     m_refCount(0)
 {
 }
 
 //=============================================================================
-template <typename T>
-TSmartPtrData<T>::~TSmartPtrData ()
+template <typename T, bool Atomic>
+TSmartPtrData<T, Atomic>::~TSmartPtrData ()
 {
-    for (auto weak : m_weaklist)
-        weak->OnObjectDestroyed();
+    // Objects deleted directly, rather than by their last release
+    DetachWeakRefs();
 
-    ASSERT(m_refCount == 0);
+    ASSERT(m_refCount.load(std::memory_order_relaxed) == 0);
 }
 
 //=============================================================================
-template <typename T>
-void TSmartPtrData<T>::IncRef ()
+template <typename T, bool Atomic>
+void TSmartPtrData<T, Atomic>::IncRef ()
 {
-    m_refCount++;
+    // A new reference is always copied from an existing one, which keeps the
+    // object alive, so nothing needs ordering
+    if (Atomic)
+        m_refCount.fetch_add(1, std::memory_order_relaxed);
+    else
+        m_refCount.store(m_refCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 }
 
 //=============================================================================
-template <typename T>
-uint TSmartPtrData<T>::DecRef ()
+template <typename T, bool Atomic>
+bool TSmartPtrData<T, Atomic>::TryIncRef ()
+{
+    uint count = m_refCount.load(std::memory_order_relaxed);
+    if (!Atomic)
+    {
+        if (!count)
+            return false;
+        m_refCount.store(count + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    while (count)
+    {
+        if (m_refCount.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+//=============================================================================
+template <typename T, bool Atomic>
+uint TSmartPtrData<T, Atomic>::DecRef ()
 {
-    ASSERT(m_refCount != 0);
-    return --m_refCount;
+    ASSERT(m_refCount.load(std::memory_order_relaxed) != 0);
+
+    // Release publishes this thread's writes to the object; acquire on the
+    // final release makes every other thread's visible to the destructor
+    if (Atomic)
+        return m_refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+
+    const uint count = m_refCount.load(std::memory_order_relaxed) - 1;
+    m_refCount.store(count, std::memory_order_relaxed);
+    return count;
 }
 
 //=============================================================================
-template <typename T>
-void TSmartPtrData<T>::AddWeakRef (TWeakPtr<T> * weak)
+template <typename T, bool Atomic>
+void TSmartPtrData<T, Atomic>::AddWeakRef (TWeakPtr<T> * weak)
 {
     m_weaklist.InsertTail(weak);
 }
 
+//=============================================================================
+template <typename T, bool Atomic>
+void TSmartPtrData<T, Atomic>::DetachWeakRefs ()
+{
+    CWeakLock lock(Atomic);
+
+    while (TWeakPtr<T> * weak = m_weaklist.Head())
+    {
+        weak->m_link.Unlink();
+        weak->OnObjectDestroyed();
+    }
+}
+
 }} // namespace Pointer::Private
\ No newline at end of file
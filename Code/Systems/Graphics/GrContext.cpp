@@ -21,7 +21,8 @@ namespace Graphics
 CContext CContext::s_context;
 
 //=============================================================================
-CContext::CContext ()
+CContext::CContext () :
+    m_debugDrawProfile(false)
 {
 }
 
@@ -33,6 +34,8 @@ CContext::~CContext ()
 //=============================================================================
 void CContext::Initialize (System::IWindow * window)
 {
+    MEM_TAG_SCOPE(Graphics);
+
     ASSERT(window);
 
     HRESULT hr;
@@ -129,6 +132,8 @@ Vector2 CContext::GetScreenSize () const
 //=============================================================================
 void CContext::Render ()
 {
+    MEM_TAG_SCOPE(Graphics);
+
     for (auto comp : m_compList)
     {
         comp->Render(&m_backbuffer);
@@ -145,6 +150,12 @@ void CContext::OnCreate (CRenderComponent * comp)
 void CContext::DebugRender ()
 {
     m_notify.Call(&CContextNotify::OnGraphicsDebugRender, Backbuffer());
+
+    if (m_debugDrawProfile)
+    {
+        const Vector2 screen = GetScreenSize();
+        DebugRenderProfile(Backbuffer(), Point2(10.0f, 10.0f), Vector2(screen.x - 20.0f, screen.y * 0.4f));
+    }
 }
 
 //=============================================================================
@@ -202,6 +213,8 @@ void CContext::OnWindowSize (const Vector2u & size)
 //=============================================================================
 IImage * CContext::ImageLoad (const CPath & filename)
 {
+    MEM_TAG_SCOPE(Graphics);
+
     ASSERT(filename.IsFile());
 
     CImage * pImage = CImage::Create(filename);
@@ -27,6 +27,8 @@ public: // Internal -----------------------------------------------------------
     void OnCreate (CImage * image);
     void OnDestroy (CImage * image);
 
+    void DebugRenderProfile (IRenderTarget * renderTarget, const Point2 & pos, const Vector2 & size);
+
 public: // Static -------------------------------------------------------------
 
     static CContext * Get () { return &s_context; }
@@ -46,6 +48,7 @@ public: // IContext -----------------------------------------------------------
     void DebugRender () override;
     void DebugText (const CString & text, const Point2 & pos, const Vector2 & size) override;
     Vector2 DebugTextMeasure (const CString & text, const Vector2 & size) override;
+    void DebugToggleProfile () override { m_debugDrawProfile = !m_debugDrawProfile; }
 
     // Images
     IImage * ImageLoad (const CPath & filename) override;
@@ -93,6 +96,9 @@ private: // -------------------------------------------------------------------
     std::vector<CImage *>   m_images;
     ListComponent           m_compList;
     CNotifier               m_notify;
+
+    // Debug
+    bool                    m_debugDrawProfile;
 };
 
 } // namespace Graphics
\ No newline at end of file
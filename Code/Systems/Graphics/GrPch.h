@@ -4,6 +4,7 @@
 #include <dwrite.h>
 
 #include "Ferrite.h"
+#include "Basics/Profile.h"
 #include "Systems\Window.h"
 #include "Systems\Graphics.h"
 
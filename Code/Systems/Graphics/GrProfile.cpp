@@ -0,0 +1,163 @@
+#include "GrPch.h"
+
+namespace Graphics
+{
+
+//*****************************************************************************
+//
+// Constants
+//
+//*****************************************************************************
+
+const float32 ROW_LABEL_WIDTH = 100.0f;
+const float32 HEADER_HEIGHT   = 16.0f;
+const float32 LANE_HEIGHT     = 14.0f;
+const float32 LABEL_MIN_WIDTH = 40.0f;  // Narrower bars go unlabelled
+const uint    MAX_LANES       = 8;      // Deeper scopes share the last lane
+
+const Color BACKGROUND_COLOR = Color(0.0f, 0.0f, 0.0f, 0.7f);
+const Color ROW_COLOR        = Color(1.0f, 1.0f, 1.0f, 0.05f);
+
+const Color PALETTE[] =
+{
+    Color(0.90f, 0.35f, 0.30f),
+    Color(0.95f, 0.60f, 0.25f),
+    Color(0.85f, 0.80f, 0.30f),
+    Color(0.45f, 0.80f, 0.35f),
+    Color(0.30f, 0.75f, 0.70f),
+    Color(0.35f, 0.55f, 0.90f),
+    Color(0.60f, 0.45f, 0.90f),
+    Color(0.85f, 0.45f, 0.75f),
+};
+
+
+
+//*****************************************************************************
+//
+// Helpers
+//
+//*****************************************************************************
+
+//=============================================================================
+static const Color & ColorForName (const char name[])
+{
+    // FNV-1a, so a scope keeps its color from frame to frame
+    uint32 hash = 2166136261u;
+    for (const char * ch = name; *ch; ++ch)
+        hash = (hash ^ uint8(*ch)) * 16777619u;
+
+    return PALETTE[hash % array_size(PALETTE)];
+}
+
+
+
+//*****************************************************************************
+//
+// CContext
+//
+//*****************************************************************************
+
+//=============================================================================
+void CContext::DebugRenderProfile (IRenderTarget * renderTarget, const Point2 & pos, const Vector2 & size)
+{
+    ASSERT(renderTarget);
+
+    Time::Point frameBegin;
+    Time::Point frameEnd;
+    if (!Profile::LastFrame(&frameBegin, &frameEnd))
+        return;
+
+    const sint64 frameNs = (frameEnd - frameBegin).GetRaw();
+    if (frameNs <= 0)
+        return;
+
+    TArray<Profile::Event> events;
+    Profile::Capture(frameBegin, frameEnd, &events);
+
+    // Each thread gets a row as deep as its deepest scope this frame
+    const uint threadCount = Profile::ThreadCount();
+    TArray<uint> rowLanes;
+    rowLanes.Resize(threadCount);
+    for (uint & lanes : rowLanes)
+        lanes = 0;
+
+    for (const Profile::Event & event : events)
+    {
+        if (event.thread < threadCount)
+            rowLanes[event.thread] = Max(rowLanes[event.thread], Min(uint(event.depth) + 1, MAX_LANES));
+    }
+
+    TArray<float32> rowTops;
+    rowTops.Resize(threadCount);
+    float32 height = HEADER_HEIGHT;
+    for (uint thread = 0; thread < threadCount; ++thread)
+    {
+        rowTops[thread] = pos.y + height;
+        height += Max(rowLanes[thread], uint(1)) * LANE_HEIGHT;
+    }
+    height = Min(height, size.y);
+
+    renderTarget->Rectangle(pos, Point2(pos.x + size.x, pos.y + height), BACKGROUND_COLOR);
+
+    // Header
+    char text[64];
+    StrPrintf(text, "Frame %.2f ms, %u events", float64(frameNs) / float64(Time::NS_PER_MS), events.Count());
+    renderTarget->Draw(CString(text), Token("Debug"), pos, Vector2(size.x, HEADER_HEIGHT));
+
+    // Thread rows
+    const float32 left  = pos.x + ROW_LABEL_WIDTH;
+    const float32 width = size.x - ROW_LABEL_WIDTH;
+    const float32 scale = width / float32(frameNs);
+    const float32 bottom = pos.y + height;
+
+    for (uint thread = 0; thread < threadCount; ++thread)
+    {
+        const float32 top = rowTops[thread];
+        if (top >= bottom)
+            break;
+
+        const float32 rowBottom = Min(top + Max(rowLanes[thread], uint(1)) * LANE_HEIGHT, bottom);
+        if (thread & 1)
+            renderTarget->Rectangle(Point2(pos.x, top), Point2(pos.x + size.x, rowBottom), ROW_COLOR);
+
+        char name[32];
+        Profile::ThreadName(thread, name, array_size(name));
+        renderTarget->Draw(CString(name), Token("Debug"), Point2(pos.x, top), Vector2(ROW_LABEL_WIDTH, LANE_HEIGHT));
+    }
+
+    // Scopes, clipped to the frame
+    for (const Profile::Event & event : events)
+    {
+        if (event.thread >= threadCount)
+            continue;
+
+        const uint    lane = Min(uint(event.depth), MAX_LANES - 1);
+        const float32 top  = rowTops[event.thread] + lane * LANE_HEIGHT;
+        if (top + LANE_HEIGHT > bottom)
+            continue;
+
+        const sint64 begin = Max(event.begin.GetRaw(), frameBegin.GetRaw()) - frameBegin.GetRaw();
+        const sint64 end   = Min(event.end.GetRaw(), frameEnd.GetRaw()) - frameBegin.GetRaw();
+
+        const float32 x0 = left + float32(begin) * scale;
+        const float32 x1 = Max(left + float32(end) * scale, x0 + 1.0f);
+
+        renderTarget->Rectangle(
+            Point2(x0, top + 1.0f),
+            Point2(x1, top + LANE_HEIGHT - 1.0f),
+            ColorForName(event.name)
+        );
+
+        if (x1 - x0 >= LABEL_MIN_WIDTH)
+        {
+            renderTarget->Draw(
+                CString(event.name),
+                Token("Debug"),
+                Point2(x0 + 2.0f, top),
+                Vector2(x1 - x0 - 2.0f, LANE_HEIGHT)
+            );
+        }
+    }
+}
+
+} // namespace Graphics
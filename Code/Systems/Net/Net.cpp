@@ -148,15 +148,15 @@ Socket Socket::Accept ()
 }
 
 //=============================================================================
-bool Socket::Send (const byte data[], unsigned len)
+unsigned Socket::Send (const byte data[], unsigned len)
 { 
     ASSERT(IsValid());
     const int ret = ::send(m_socket, (const char *)data, len, 0);
     if (ret > 0)
-        return true;
+        return ret;
 
     HandleErrors();
-    return false;
+    return 0;
 }
 
 //=============================================================================
@@ -179,6 +179,34 @@ uint Socket::BytesAvailable () const
     return bytes;
 }
 
+//=============================================================================
+bool Socket::IsReadable () const
+{
+    return Poll(true);
+}
+
+//=============================================================================
+bool Socket::IsWritable () const
+{
+    return Poll(false);
+}
+
+//=============================================================================
+bool Socket::Poll (bool read) const
+{
+    if (!IsValid())
+        return false;
+
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(SOCKET(m_socket), &set);
+
+    // Zero timeout: report the current state without blocking
+    timeval timeout = { 0, 0 };
+    const int ret = ::select(0, read ? &set : null, read ? null : &set, null, &timeout);
+    return ret > 0;
+}
+
 //=============================================================================
 void Socket::SetBlocking (bool value)
 {
@@ -234,3 +262,23 @@ void Socket::HandleErrors ()
 
     }
 }
+
+
+
+#if defined(__cpp_impl_coroutine)
+
+//=============================================================================
+Job::CUntil SocketReadable (const Socket & socket)
+{
+    const Socket * ptr = &socket;
+    return Job::Until([ptr] { return ptr->IsReadable(); });
+}
+
+//=============================================================================
+Job::CUntil SocketWritable (const Socket & socket)
+{
+    const Socket * ptr = &socket;
+    return Job::Until([ptr] { return ptr->IsWritable(); });
+}
+
+#endif // __cpp_impl_coroutine
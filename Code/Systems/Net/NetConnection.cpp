@@ -19,28 +19,33 @@ CConnection::~CConnection ()
 //=============================================================================
 void CConnection::Update ()
 {
-    // Read in available data
-    if (const uint bytesAvailable = m_socket.BytesAvailable())
+    // Read available data straight into the receive buffer
+    for (uint bytesAvailable = m_socket.BytesAvailable(); bytesAvailable; )
     {
-        TArray<byte> buffer;
-        buffer.Resize(bytesAvailable);
+        uint count = bytesAvailable;
+        byte * ptr = m_readBuffer.ReserveWrite(&count);
 
-        m_socket.Recv(buffer.Ptr(), buffer.Count());
+        const uint received = m_socket.Recv(ptr, count);
+        m_readBuffer.CommitWrite(received);
 
-        m_readBuffer.AddBack(buffer);
+        if (received < count)
+            break;
+
+        bytesAvailable -= received;
     }
 
-    // Send off waiting data
-    if (m_sendBuffer.Count())
+    // Send waiting data straight out of the send buffer, at most two runs.
+    // Whatever the socket did not take stays queued for the next update.
+    while (!m_sendBuffer.IsEmpty())
     {
-        // Need to copy to continuous memory before sending
-        TArray<byte> sendArray;
-        sendArray.Reserve(m_sendBuffer.Count());
-        std::copy(m_sendBuffer.begin(), m_sendBuffer.end(), sendArray.begin());
+        uint count = 0;
+        const byte * ptr = m_sendBuffer.PeekContiguous(&count);
 
-        m_socket.Send(sendArray.Ptr(), sendArray.Count());
+        const uint sent = m_socket.Send(ptr, count);
+        m_sendBuffer.CommitRead(sent);
 
-        m_sendBuffer.Clear();
+        if (sent < count)
+            break;
     }
 }
 
@@ -55,8 +60,17 @@ void CConnection::Read (byte data[], const uint length)
 {
     ASSERT(length <= m_readBuffer.Count());
 
-    std::copy(m_readBuffer.begin(), m_readBuffer.end(), data);
-    m_readBuffer.Remove(0, length);
+    // Copy out in at most two runs when the data wraps the ring buffer
+    for (uint copied = 0; copied < length; )
+    {
+        uint count = 0;
+        const byte * ptr = m_readBuffer.PeekContiguous(&count);
+        count = Min(count, length - copied);
+
+        MemCopy(data + copied, ptr, count);
+        m_readBuffer.CommitRead(count);
+        copied += count;
+    }
 }
 
 //=============================================================================
@@ -24,6 +24,9 @@ void CManager::OnCreate (CConnection * connection)
 //=============================================================================
 void CManager::Update ()
 {
+    MEM_TAG_SCOPE(Net);
+    PROFILE_SCOPE("Net::Update");
+
     // Create new connections
     while (m_listenSocket.Listen(m_listenPort))
     {
@@ -1,5 +1,6 @@
 
 #include "Ferrite.h"
+#include "Basics/Profile.h"
 #include "Systems/Net.h"
 
 #include "NetConnection.h"
@@ -45,6 +45,9 @@ CContext::~CContext ()
 //=============================================================================
 void CContext::Update ()
 {
+    MEM_TAG_SCOPE(Pathing);
+    PROFILE_SCOPE("Pathing::Update");
+
     m_debugUpdateCount = 0;
 
     CRealTimer timer;
@@ -11,8 +11,6 @@ public: // Internal -----------------------------------------------------------
     CContext ();
     ~CContext ();
 
-    CNodeAllocator & GetNodeAllocator () { return m_nodeAllocator; }
-    CProxyAllocator & GetProxyAllocator () { return m_proxyAllocator; }
     Notifier & GetNotifier () { return m_notifier; }
 
 public: // Static -------------------------------------------------------------
@@ -52,8 +50,6 @@ private: // -------------------------------------------------------------------
     GraphList       m_graphs;
     QueryList       m_queries;
     QueryList       m_queriesFinished;
-    CNodeAllocator  m_nodeAllocator;
-    CProxyAllocator m_proxyAllocator;
     Notifier        m_notifier;
 
     // Debug
@@ -11,16 +11,12 @@ CGraph::CGraph ()
 //=============================================================================
 CGraph::~CGraph ()
 {
-    for (CNode * node : m_nodes)
-        delete node;
 }
 
 //=============================================================================
 INode * CGraph::NodeAdd (IData * data)
 {
-    CNode * node = new CNode(data);
-    m_nodes.Add(node);
-    return node;
+    return m_nodes.New(data);
 }
 
 //=============================================================================
@@ -48,8 +44,8 @@ TArray<INode *> CGraph::GetNodes ()
     TArray<INode *> outNodes;
     outNodes.Reserve(m_nodes.Count());
 
-    for (CNode * node : m_nodes)
-        outNodes.Add(node);
+    for (CNode & node : m_nodes)
+        outNodes.Add(&node);
 
     return outNodes;
 }
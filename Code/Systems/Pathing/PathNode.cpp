@@ -15,18 +15,6 @@ CNode::~CNode ()
     delete m_data;
 }
 
-//=============================================================================
-void * CNode::operator new (size_t)
-{
-    return CContext::Get()->GetNodeAllocator().Alloc();
-}
-
-//=============================================================================
-void CNode::operator delete (void * ptr)
-{
-    CContext::Get()->GetNodeAllocator().Free(ptr);
-}
-
 //=============================================================================
 void CNode::AddNeighbor (CNode * node)
 {
@@ -3,7 +3,8 @@ namespace Pathing
 
 class CNode;
 
-typedef TArray<CNode *> NodeArray;
+typedef TStableArray<CNode> NodeArray;   // Nodes never move, so edges can hold raw pointers
+typedef TInlineArray<CNode *, 8> NeighborArray; // Typical grid graphs have at most 8 neighbors
 
 
 class CNode :
@@ -17,10 +18,7 @@ public: // Internal -----------------------------------------------------------
 
     void AddNeighbor (CNode * node);
 
-    inline const NodeArray & Neighbors () const { return m_neighbors; }
-
-    void * operator new (size_t);
-    void operator delete (void * ptr);
+    inline const NeighborArray & Neighbors () const { return m_neighbors; }
 
 public: // INode --------------------------------------------------------------
 
@@ -30,11 +28,9 @@ public: // INode --------------------------------------------------------------
 
 private: // Data --------------------------------------------------------------
 
-    NodeArray m_neighbors;
+    NeighborArray m_neighbors;
     IData *   m_data;
 
 };
 
-typedef TBlockAllocator<CNode, 32> CNodeAllocator;
-
 } // namespace Pathing
\ No newline at end of file
@@ -1,5 +1,6 @@
 
 #include "Ferrite.h"
+#include "Basics/Profile.h"
 #include "Basics/Time.h"
 #include "Utilities/Allocator.h"
 #include "Systems/Pathing.h"
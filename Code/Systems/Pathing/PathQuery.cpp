@@ -15,6 +15,7 @@ namespace Pathing
 Proxy::Proxy (CNode * node) :
     graphNode(node),
     location(ELocation::None),
+    openHandle(ProxyQueue::INVALID_HANDLE),
     score(0.0f),
     heuristic(0.0f),
     total(0.0f),
@@ -22,18 +23,6 @@ Proxy::Proxy (CNode * node) :
 {
 }
 
-//=============================================================================
-void * Proxy::operator new (size_t)
-{
-    return CContext::Get()->GetProxyAllocator().Alloc();
-}
-
-//=============================================================================
-void Proxy::operator delete (void * ptr)
-{
-    CContext::Get()->GetProxyAllocator().Free(ptr);
-}
-
 
 
 //=============================================================================
@@ -63,8 +52,6 @@ CQuery::CQuery (
 //=============================================================================
 CQuery::~CQuery ()
 {
-    for (auto it : m_lookup)
-        delete it.second;
 }
 
 //=============================================================================
@@ -77,6 +64,7 @@ void CQuery::Update ()
         return Finalize(EState::Failed);
 
     Proxy * current = m_open.Pop();
+    current->openHandle = ProxyQueue::INVALID_HANDLE;
     if  (current->graphNode == m_goal)
         return Finalize(EState::Success);
 
@@ -105,7 +93,7 @@ void CQuery::Update ()
             neighborProxy->previous   = current;
             neighborProxy->score      = tentativeScore;
             neighborProxy->total      = neighborProxy->score + neighborProxy->heuristic;
-            m_open.Resort();
+            m_open.DecreaseKey(neighborProxy->openHandle);
         }
     }
 }
@@ -118,7 +106,7 @@ Proxy * CQuery::GetProxy (CNode * node)
     Proxy * proxy = m_lookup.Find(node);
     if (!proxy)
     {
-        proxy = new Proxy(node);
+        proxy = m_proxies.New(node);
         proxy->heuristic = m_heuristic(node, m_goal);
 
         m_lookup.Set(node, proxy);
@@ -136,8 +124,8 @@ const Proxy * CQuery::GetProxy (CNode * node) const
 //=============================================================================
 void CQuery::PutInOpen (Proxy * proxy)
 {
-    proxy->location = Proxy::ELocation::Open;
-    m_open.Push(proxy);
+    proxy->location   = Proxy::ELocation::Open;
+    proxy->openHandle = m_open.Push(proxy);
 }
 
 //=============================================================================
@@ -153,7 +141,7 @@ TArray<INode *> CQuery::GetPath () const
 
     const Proxy * proxy = GetProxy(m_goal);
 
-    const bool isInOpen = m_open.Contains(const_cast<Proxy * const>(proxy));
+    const bool isInOpen = proxy && m_open.ContainsHandle(proxy->openHandle);
     if (isInOpen)
         return TArray<INode *>();
 
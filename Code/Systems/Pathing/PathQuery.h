@@ -9,6 +9,16 @@ namespace Pathing
 //
 //============================================================================
 
+struct Proxy;
+
+struct ProxyCompare
+{
+    // Lowest total is the highest priority
+    inline bool operator() (const Proxy * lhs, const Proxy * rhs) const;
+};
+
+typedef TPriQueue<Proxy *, ProxyCompare> ProxyQueue;
+
 struct Proxy
 {
     explicit Proxy (CNode * node);
@@ -22,6 +32,7 @@ struct Proxy
 
     CNode *         graphNode;
     ELocation       location;
+    ProxyQueue::Handle openHandle;  // Handle into the open queue while location is Open
     float           score;      // G
     float           heuristic;  // H
     float           total;      // F = G + H
@@ -29,12 +40,13 @@ struct Proxy
 
     bool operator== (const CNode * rhs) const { return graphNode == rhs; }
     bool operator< (const Proxy & rhs) const { return total > rhs.total; }
-
-    void * operator new (size_t);
-    void operator delete (void * ptr);
 };
 
-typedef TBlockAllocator<Proxy, 64> CProxyAllocator;
+//=============================================================================
+bool ProxyCompare::operator() (const Proxy * lhs, const Proxy * rhs) const
+{
+    return lhs->total > rhs->total;
+}
 
 
 
@@ -78,8 +90,8 @@ private: // -------------------------------------------------------------------
 
     typedef TDictionary<const CNode *, Proxy *> MapNodeToProxy;
     typedef TSet<Proxy *>                       ProxySet;
-    typedef TPriQueue<Proxy *>                  ProxyQueue;
     typedef TArray<Proxy *>                     ProxyArray;
+    typedef TStableArray<Proxy>                 ProxyStore;
 
     enum class EState
     {
@@ -91,6 +103,7 @@ private: // -------------------------------------------------------------------
     // Data
     EState          m_state;
     CGraph          m_graph;
+    ProxyStore      m_proxies;
     MapNodeToProxy  m_lookup;
     ProxyQueue      m_open;
     CNode *         m_start;
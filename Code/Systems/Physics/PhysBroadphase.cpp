@@ -4,11 +4,11 @@ namespace Physics
 {
 
 //=============================================================================
-TArray<CColliderComponent *> CBroadphase::Find (const Circle & circle, Flags32 group)
+TFrameArray<CColliderComponent *> CBroadphase::Find (const Circle & circle, Flags32 group)
 {
     // TODO: check the data structure for objects nearby
 
-    TArray<CColliderComponent *> out;
+    TFrameArray<CColliderComponent *> out;
     for (auto * collider : m_colliders)
     {
         if (!collider->GetGroups().Test(group))
@@ -21,11 +21,11 @@ TArray<CColliderComponent *> CBroadphase::Find (const Circle & circle, Flags32 g
 }
 
 //=============================================================================
-TArray<CColliderComponent *> CBroadphase::Find (const Aabb2 & box, Flags32 group)
+TFrameArray<CColliderComponent *> CBroadphase::Find (const Aabb2 & box, Flags32 group)
 {
     // TODO: check the data structure for objects nearby
 
-    TArray<CColliderComponent *> out;
+    TFrameArray<CColliderComponent *> out;
     for (auto * collider : m_colliders)
     {
         if (!collider->GetGroups().Test(group))
@@ -5,8 +5,10 @@ class CBroadphase
 {
 public:
 
-    TArray<CColliderComponent *> Find (const Circle & cirle, Flags32 group);
-    TArray<CColliderComponent *> Find (const Aabb2 & box, Flags32 group);
+    // Results come from the calling thread's frame arena and must not be kept
+    // past the end of the frame
+    TFrameArray<CColliderComponent *> Find (const Circle & cirle, Flags32 group);
+    TFrameArray<CColliderComponent *> Find (const Aabb2 & box, Flags32 group);
 
     void Add (CColliderComponent * collider);
     void Remove (CColliderComponent * collider);
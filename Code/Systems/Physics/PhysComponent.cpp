@@ -157,26 +157,26 @@ Polygon2 CColliderComponent::GetPolygon () const
             const uint numPoints = Max(FloatToUint(circumference / LINEAR_SPACE + 0.5f), 3u);
             const Radian spacing(Math::Tau / numPoints);
             
-            TArray<Point2> points;
-            points.Reserve(numPoints);
+            Polygon2 polygon;
+            polygon.points.Reserve(numPoints);
 
             Radian angle(0);
             for (uint i = 0; i < numPoints; ++i, angle+=spacing)
             {
                 const Point2 p(Cos(angle), Sin(angle));
-                points.Add(matrix * p);
+                polygon.points.Add(matrix * p);
             }
 
-            return Polygon2(points);
+            return polygon;
         }
         break;
 
         case EType::Box:
         {
-            TArray<Point2> points = m_aabb.GetPoints();
-            for (Point2 & p : points)
-                p = matrix * p;
-            return Polygon2(points);
+            Polygon2 polygon;
+            for (const Point2 & p : m_aabb.GetPoints())
+                polygon.points.Add(matrix * p);
+            return polygon;
         }
         break;
     }
@@ -75,6 +75,9 @@ void CContext::DebugToggleCollider ()
 //=============================================================================
 void CContext::Update (Time::Delta deltaTime)
 {
+    MEM_TAG_SCOPE(Physics);
+    PROFILE_SCOPE("Physics::Update");
+
     uint counter = 0;
     m_debugCollisionCount = 0;
 
@@ -99,6 +102,7 @@ void CContext::Update (Time::Delta deltaTime)
 //=============================================================================
 void CContext::Tick ()
 {
+    PROFILE_SCOPE("Physics::Tick");
     Detection();
     Integrate();
 }
@@ -106,6 +110,8 @@ void CContext::Tick ()
 //=============================================================================
 void CContext::Detection ()
 {
+    PROFILE_SCOPE("Physics::Detection");
+
     // TODO: find potential collection sets
 
     for (auto * colliderA = m_colliderList.Head(); colliderA; colliderA = m_colliderList.Next(colliderA))
@@ -279,6 +285,8 @@ void CContext::Response (
 //=============================================================================
 void CContext::Integrate()
 {
+    PROFILE_SCOPE("Physics::Integrate");
+
     const float dt = TIME_STEP.GetSeconds();
     for (auto * rigidBody : m_rigidBodyList)
     {
@@ -15,6 +15,7 @@
 
 #include "Ferrite.h"
 #include "Basics/Geometry.h"
+#include "Basics/Profile.h"
 #include "Systems/Physics.h"
 #include "Systems/Graphics.h"
 
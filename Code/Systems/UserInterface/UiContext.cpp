@@ -60,6 +60,9 @@ void CContext::Uninitialize ()
 //=============================================================================
 void CContext::Update (const Time::Delta deltaTime)
 {
+    MEM_TAG_SCOPE(UI);
+    PROFILE_SCOPE("UI::Update");
+
     if (!m_root)
         return;
 
@@ -79,6 +82,7 @@ void CContext::Update (const Time::Delta deltaTime)
         proxy->Update();
 
     // Layout all widgets that require
+    PROFILE_SCOPE("UI::Layout");
     while (CProxy * proxy = m_needsLayout.Head())
     {
         proxy->m_linkLayout.Unlink();
@@ -91,6 +95,9 @@ void CContext::Update (const Time::Delta deltaTime)
 //=============================================================================
 void CContext::Render ()
 {
+    MEM_TAG_SCOPE(UI);
+    PROFILE_SCOPE("UI::Render");
+
     for (auto proxy : m_proxies)
         proxy->Render();
 }
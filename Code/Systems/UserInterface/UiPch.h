@@ -1,6 +1,7 @@
 
 #include "Ferrite.h"
 #include "Basics/Geometry.h"
+#include "Basics/Profile.h"
 #include "Systems/UserInterface.h"
 #include "Systems/Graphics.h"
 #include "Systems/Window.h"
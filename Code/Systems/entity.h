@@ -57,7 +57,7 @@ IEntityContext * EntityGetContext ();
 //
 //=============================================================================
 
-interface IEntity : IRefCounted<IEntity>
+interface IEntity : IRefCounted<IEntity, true>
 {
     virtual EntityId GetId () const pure;
 
@@ -157,6 +157,7 @@ interface IContext
     virtual void DebugRender () pure;
     virtual void DebugText (const CString & text, const Point2 & pos, const Vector2 & size = Vector2::Infinity) pure;
     virtual Vector2 DebugTextMeasure (const CString & text, const Vector2 & size) pure;
+    virtual void DebugToggleProfile () pure;    // Profiler timeline of the last frame, see Basics/Profile.h
 
     // Images
     virtual IImage * ImageLoad (const CPath & filename) pure;
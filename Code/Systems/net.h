@@ -3,6 +3,7 @@
 
 #include "Utilities/Notifier.h"
 #include "Basics/Time.h"
+#include "Basics/Task.h"
 
 //=============================================================================
 //
@@ -54,9 +55,14 @@ public:
 
     Socket Accept ();
 
-    bool Send (const byte data[], unsigned len);
+    unsigned Send (const byte data[], unsigned len);   // Bytes written, which may be fewer than len
     unsigned Recv (byte data[], unsigned len);
     uint BytesAvailable () const;
+
+    // Readable once data, a connection to accept, or a close is waiting;
+    // writable once a non-blocking connect completes or the send buffer has room
+    bool IsReadable () const;
+    bool IsWritable () const;
     
 
     void SetBlocking (bool value);
@@ -68,12 +74,30 @@ private:
 
     void Init ();
     void HandleErrors ();
+    bool Poll (bool read) const;
 
     intptr_t m_socket;
 };
 
 
 
+#if defined(__cpp_impl_coroutine)
+
+//=============================================================================
+//
+// Socket awaitables
+//
+// Suspend a task until the socket is ready, polled once per frame by
+// Job::UpdateTasks. The socket must outlive the wait.
+//
+//=============================================================================
+Job::CUntil SocketReadable (const Socket & socket);
+Job::CUntil SocketWritable (const Socket & socket);
+
+#endif // __cpp_impl_coroutine
+
+
+
 namespace Network
 {
 
@@ -1,3 +1,103 @@
+#include <algorithm>
+
+namespace Private
+{
+
+//*****************************************************************************
+//
+// AllocatorThreadSlot
+//
+//*****************************************************************************
+
+struct AllocatorRegistry
+{
+    Lockable                   lock;
+    TArray<CAllocatorCaches *> allocators;
+    bool                       slotUsed[ALLOCATOR_MAX_THREAD_SLOTS] = {};
+};
+
+// Releases the thread's slot as the thread exits
+struct AllocatorSlotOwner
+{
+    uint * slot;
+    inline ~AllocatorSlotOwner ();
+};
+
+const uint ALLOCATOR_SLOT_UNASSIGNED = ALLOCATOR_MAX_THREAD_SLOTS + 1;
+
+//=============================================================================
+inline AllocatorRegistry & GetAllocatorRegistry ()
+{
+    // Never destroyed, so allocators and threads may outlive static teardown
+    static AllocatorRegistry * s_registry = new AllocatorRegistry;
+    return *s_registry;
+}
+
+//=============================================================================
+void AllocatorRegister (CAllocatorCaches * allocator)
+{
+    AllocatorRegistry & registry = GetAllocatorRegistry();
+    registry.lock.Lock();
+    registry.allocators.Add(allocator);
+    registry.lock.Unlock();
+}
+
+//=============================================================================
+void AllocatorUnregister (CAllocatorCaches * allocator)
+{
+    AllocatorRegistry & registry = GetAllocatorRegistry();
+    registry.lock.Lock();
+    registry.allocators.RemoveUnordered(registry.allocators.Find(allocator));
+    registry.lock.Unlock();
+}
+
+//=============================================================================
+AllocatorSlotOwner::~AllocatorSlotOwner ()
+{
+    const uint index = *slot;
+
+    // Later allocations on this thread bypass the caches
+    *slot = ALLOCATOR_MAX_THREAD_SLOTS;
+    if (index == ALLOCATOR_MAX_THREAD_SLOTS)
+        return;
+
+    AllocatorRegistry & registry = GetAllocatorRegistry();
+    registry.lock.Lock();
+    for (CAllocatorCaches * allocator : registry.allocators)
+        allocator->FlushSlot(index);
+    registry.slotUsed[index] = false;
+    registry.lock.Unlock();
+}
+
+//=============================================================================
+uint AllocatorThreadSlot ()
+{
+    static thread_local uint s_slot = ALLOCATOR_SLOT_UNASSIGNED;
+    if (s_slot != ALLOCATOR_SLOT_UNASSIGNED)
+        return s_slot;
+
+    static thread_local AllocatorSlotOwner s_owner = { &s_slot };
+    s_slot = ALLOCATOR_MAX_THREAD_SLOTS;
+
+    AllocatorRegistry & registry = GetAllocatorRegistry();
+    registry.lock.Lock();
+    for (uint index = 0; index < ALLOCATOR_MAX_THREAD_SLOTS; ++index)
+    {
+        if (!registry.slotUsed[index])
+        {
+            registry.slotUsed[index] = true;
+            s_slot = index;
+            break;
+        }
+    }
+    registry.lock.Unlock();
+
+    return s_slot;
+}
+
+} // namespace Private
+
+
 
 //*****************************************************************************
 //
@@ -9,6 +109,11 @@
 template <typename T, uint C>
 TBlockAllocator<T, C>::TBlockAllocator ()
 {
+#ifdef BLOCK_ALLOCATOR_VALIDATE
+    m_allocCount = 0;
+#endif
+
+    Private::AllocatorRegister(this);
 }
 
 //=============================================================================
@@ -19,17 +124,18 @@ TBlockAllocator<T, C>::~TBlockAllocator ()
     ASSERT(m_allocCount == 0);
 #endif
 
+    Private::AllocatorUnregister(this);
     Clear();
 }
 
 //=============================================================================
 template <typename T, uint C>
 template <typename... Args>
-T * TBlockAllocator<T, C>::New (const Args &... args)
+T * TBlockAllocator<T, C>::New (Args &&... args)
 {
-    void * obj = New();
+    void * obj = Alloc();
 
-    return new(obj) T(args...);
+    return new(obj) T(std::forward<Args>(args)...);
 }
 
 //=============================================================================
@@ -38,23 +144,48 @@ void TBlockAllocator<T, C>::Delete (T * obj)
 {
     obj->~T();
 
-    Delete(obj);
+    Free(obj);
 }
 
 //=============================================================================
 template <typename T, uint C>
-void * TBlockAllocator<T, C>::Alloc ()
+void TBlockAllocator<T, C>::DeleteShared (T * obj)
 {
-    if (!m_objList)
-        Grow();
+    obj->~T();
 
-    void * obj = m_objList;
-    m_objList = m_objList->next;
+    FreeShared(obj);
+}
 
+//=============================================================================
+template <typename T, uint C>
+void * TBlockAllocator<T, C>::Alloc ()
+{
 #ifdef BLOCK_ALLOCATOR_VALIDATE
     m_allocCount++;
 #endif
 
+    Cache * cache = LockCache(Private::AllocatorThreadSlot());
+    if (!cache)
+    {
+        // Thread without a cache, or one being flushed; go straight to the depot
+        m_lock.Lock();
+        if (!m_objList)
+            Grow();
+        FreeObj * obj = m_objList;
+        m_objList = obj->next;
+        m_objCount--;
+        m_lock.Unlock();
+        return obj;
+    }
+
+    if (!cache->list)
+        Refill(cache);
+
+    FreeObj * obj = cache->list;
+    cache->list = obj->next;
+    cache->count--;
+
+    UnlockCache(cache);
     return obj;
 }
 
@@ -62,26 +193,260 @@ void * TBlockAllocator<T, C>::Alloc ()
 template <typename T, uint C>
 void TBlockAllocator<T, C>::Free (void * obj)
 {
+#ifdef BLOCK_ALLOCATOR_VALIDATE
+    ASSERT(m_allocCount > 0); // Double delete?
+    m_allocCount--;
+#endif
+
     FreeObj * freeObj = static_cast<FreeObj *>(obj);
 
-    freeObj->next = m_objList;
-    m_objList     = freeObj;
+    Cache * cache = LockCache(Private::AllocatorThreadSlot());
+    if (!cache)
+    {
+        m_lock.Lock();
+        freeObj->next = m_objList;
+        m_objList     = freeObj;
+        m_objCount++;
+        m_lock.Unlock();
+        return;
+    }
+
+    freeObj->next = cache->list;
+    cache->list   = freeObj;
+    cache->count++;
+
+    // Keep one batch in hand and hand the rest back
+    if (cache->count >= BATCH * 2)
+        Release(cache, BATCH);
 
+    UnlockCache(cache);
+}
+
+//=============================================================================
+template <typename T, uint C>
+void TBlockAllocator<T, C>::FreeShared (void * obj)
+{
 #ifdef BLOCK_ALLOCATOR_VALIDATE
     ASSERT(m_allocCount > 0); // Double delete?
     m_allocCount--;
 #endif
+
+    FreeObj * freeObj = static_cast<FreeObj *>(obj);
+
+    m_lock.Lock();
+    freeObj->next = m_objList;
+    m_objList     = freeObj;
+    m_objCount++;
+    m_lock.Unlock();
+}
+
+//=============================================================================
+template <typename T, uint C>
+void TBlockAllocator<T, C>::Flush ()
+{
+    // Caches in use right now are skipped; their owners are about to touch
+    // them again anyway
+    m_lock.Lock();
+    for (uint slot = 0; slot < Private::ALLOCATOR_MAX_THREAD_SLOTS; ++slot)
+    {
+        if (Cache * cache = LockCache(slot))
+        {
+            Drain(cache);
+            UnlockCache(cache);
+        }
+    }
+    m_lock.Unlock();
+}
+
+//=============================================================================
+template <typename T, uint C>
+void TBlockAllocator<T, C>::FlushSlot (uint slot)
+{
+    m_lock.Lock();
+    if (Cache * cache = LockCache(slot))
+    {
+        Drain(cache);
+        UnlockCache(cache);
+    }
+    m_lock.Unlock();
+}
+
+//=============================================================================
+template <typename T, uint C>
+uint TBlockAllocator<T, C>::Trim ()
+{
+    Flush();
+
+    m_lock.Lock();
+
+    // Sort blocks by address so each free object can find its block quickly
+    TArray<Block *> blocks;
+    for (Block * block = m_blockList; block; block = block->next)
+        blocks.Add(block);
+    std::sort(blocks.begin(), blocks.end());
+
+    TArray<uint> freeCounts;
+    freeCounts.Resize(blocks.Count());
+    std::fill(freeCounts.begin(), freeCounts.end(), 0);
+
+    auto findBlock = [&blocks](const FreeObj * obj) {
+        Block * const * it = std::upper_bound(blocks.begin(), blocks.end(), (Block *)obj);
+        return uint(it - blocks.begin()) - 1;
+    };
+
+    for (FreeObj * obj = m_objList; obj; obj = obj->next)
+        freeCounts[findBlock(obj)]++;
+
+    // Drop free objects that live in fully free blocks
+    FreeObj ** link = &m_objList;
+    while (FreeObj * obj = *link)
+    {
+        if (freeCounts[findBlock(obj)] == C)
+        {
+            *link = obj->next;
+            m_objCount--;
+        }
+        else
+        {
+            link = &obj->next;
+        }
+    }
+
+    // Then release those blocks
+    uint freed = 0;
+    Block ** blockLink = &m_blockList;
+    while (Block * block = *blockLink)
+    {
+        const uint index = findBlock((const FreeObj *)block->objects);
+        if (freeCounts[index] == C)
+        {
+            *blockLink = block->next;
+            delete block;
+            freed++;
+        }
+        else
+        {
+            blockLink = &block->next;
+        }
+    }
+
+    m_lock.Unlock();
+    return freed;
 }
 
 //=============================================================================
 template <typename T, uint C>
 void TBlockAllocator<T, C>::Clear ()
 {
+    for (Cache & cache : m_caches)
+    {
+        cache.list  = null;
+        cache.count = 0;
+    }
+
+    m_lock.Lock();
+
     for (Block * next; m_blockList; m_blockList = next)
     {
         next = m_blockList->next;
         delete m_blockList;
     }
+
+    m_objList  = null;
+    m_objCount = 0;
+
+    m_lock.Unlock();
+}
+
+//=============================================================================
+template <typename T, uint C>
+typename TBlockAllocator<T, C>::Cache * TBlockAllocator<T, C>::LockCache (uint slot)
+{
+    if (slot >= Private::ALLOCATOR_MAX_THREAD_SLOTS)
+        return null;
+
+    // Never waits. Only the owner and Flush take it, and whichever finds it
+    // held goes through the depot or skips the cache instead.
+    Cache * cache = &m_caches[slot];
+    if (cache->busy.exchange(true, std::memory_order_acquire))
+        return null;
+    return cache;
+}
+
+//=============================================================================
+template <typename T, uint C>
+void TBlockAllocator<T, C>::UnlockCache (Cache * cache)
+{
+    cache->busy.store(false, std::memory_order_release);
+}
+
+//=============================================================================
+template <typename T, uint C>
+void TBlockAllocator<T, C>::Refill (Cache * cache)
+{
+    m_lock.Lock();
+
+    while (m_objCount < BATCH)
+        Grow();
+
+    // Detach a batch from the front of the depot list
+    FreeObj * first = m_objList;
+    FreeObj * last  = first;
+    for (uint i = 1; i < BATCH; ++i)
+        last = last->next;
+
+    m_objList   = last->next;
+    m_objCount -= BATCH;
+
+    m_lock.Unlock();
+
+    last->next   = cache->list;
+    cache->list  = first;
+    cache->count += BATCH;
+}
+
+//=============================================================================
+template <typename T, uint C>
+void TBlockAllocator<T, C>::Release (Cache * cache, uint count)
+{
+    if (!count)
+        return;
+
+    ASSERT(count <= cache->count);
+
+    // Detach the batch outside the lock, then splice it in with one pointer swap
+    FreeObj * first = cache->list;
+    FreeObj * last  = first;
+    for (uint i = 1; i < count; ++i)
+        last = last->next;
+
+    cache->list   = last->next;
+    cache->count -= count;
+
+    m_lock.Lock();
+    last->next  = m_objList;
+    m_objList   = first;
+    m_objCount += count;
+    m_lock.Unlock();
+}
+
+//=============================================================================
+template <typename T, uint C>
+void TBlockAllocator<T, C>::Drain (Cache * cache)
+{
+    if (!cache->count)
+        return;
+
+    FreeObj * last = cache->list;
+    while (last->next)
+        last = last->next;
+
+    last->next  = m_objList;
+    m_objList   = cache->list;
+    m_objCount += cache->count;
+
+    cache->list  = null;
+    cache->count = 0;
 }
 
 //=============================================================================
@@ -102,4 +467,5 @@ void TBlockAllocator<T, C>::Grow ()
         freeObj->next = m_objList;
         m_objList = freeObj;
     }
-}
\ No newline at end of file
+    m_objCount += C;
+}
@@ -41,6 +41,13 @@ TId<Tag, T> & TId<Tag, T>::operator++ (int)
     return *this;
 }
 
+//=============================================================================
+template <typename Tag, typename T>
+T TId<Tag, T>::GetRaw () const
+{
+    return m_id;
+}
+
 //=============================================================================
 template <typename Tag, typename T> bool operator== (TId<Tag, T> lhs, TId<Tag, T> rhs) { return lhs.m_id == rhs.m_id; }
 template <typename Tag, typename T> bool operator!= (TId<Tag, T> lhs, TId<Tag, T> rhs) { return lhs.m_id != rhs.m_id; }
@@ -37,6 +37,8 @@ void CDocument::Parse (const CPath & filepath)
 //=============================================================================
 void CDocument::Parse (const CString & string)
 {
+    PROFILE_SCOPE("Json::Parse");
+
     m_read = string.begin();
 
     // Do initial error checking
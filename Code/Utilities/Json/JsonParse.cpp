@@ -427,6 +427,8 @@ bool ParseValue (const CString::Iterator * read, CValue * out)
 //=============================================================================
 CValue Parse (const CString & string)
 {
+    MEM_TAG_SCOPE(Json);
+
     CString::Iterator read = string.begin();
     
     ObjectType object;
@@ -2,6 +2,7 @@
 #include "Ferrite.h"
 
 #include "Basics/File.h"
+#include "Basics/Profile.h"
 #include "Utilities/Json.h"
 
 
@@ -0,0 +1,290 @@
+#include <algorithm>
+
+namespace Private
+{
+
+//*****************************************************************************
+//
+// Constants
+//
+//*****************************************************************************
+
+const uint RADIX_SORT_MIN_COUNT    = 256;       // Below this a comparison sort wins
+const uint PARALLEL_SORT_MIN_SLICE = 16 * 1024; // Smallest slice worth a job
+
+
+
+//*****************************************************************************
+//
+// TRadixKey
+//
+// Maps a key to an unsigned integer of the same size whose natural order is
+// the key's order.
+//
+//*****************************************************************************
+
+template <typename K, typename Enable = void>
+struct TRadixKey;
+
+template <typename K>
+struct TRadixKey<K, typename std::enable_if<std::is_integral<K>::value && std::is_unsigned<K>::value>::type>
+{
+    typedef K Type;
+    static Type Get (K key) { return key; }
+};
+
+template <typename K>
+struct TRadixKey<K, typename std::enable_if<std::is_integral<K>::value && std::is_signed<K>::value>::type>
+{
+    typedef typename std::make_unsigned<K>::type Type;
+
+    // Flipping the sign bit moves negatives below positives
+    static Type Get (K key) { return Type(key) ^ (Type(1) << (sizeof(K) * 8 - 1)); }
+};
+
+template <>
+struct TRadixKey<float32>
+{
+    typedef uint32 Type;
+
+    // Negatives reverse their order by flipping all bits, positives set the sign
+    static Type Get (float32 key)
+    {
+        uint32 bits;
+        MemCopy(&bits, &key, sizeof(bits));
+        return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+    }
+};
+
+template <>
+struct TRadixKey<float64>
+{
+    typedef uint64 Type;
+
+    static Type Get (float64 key)
+    {
+        uint64 bits;
+        MemCopy(&bits, &key, sizeof(bits));
+        return (bits >> 63) ? ~bits : (bits | (uint64(1) << 63));
+    }
+};
+
+
+
+//*****************************************************************************
+//
+// Helpers
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, typename A, typename F>
+void RadixSort (TArray<T, A> & arr, F key)
+{
+    typedef typename std::decay<decltype(key(arr[0]))>::type Key;
+    typedef TRadixKey<Key>                                    Radix;
+    typedef typename Radix::Type                              Bits;
+
+    const uint PASSES = sizeof(Bits);
+    const uint count  = arr.Count();
+
+    // Extract every key once and histogram all digits in a single pass
+    TArray<Bits> keys;
+    keys.Resize(count);
+
+    uint histogram[PASSES][256] = {};
+    for (uint i = 0; i < count; ++i)
+    {
+        const Bits bits = Radix::Get(key(arr[i]));
+        keys[i] = bits;
+        for (uint pass = 0; pass < PASSES; ++pass)
+            histogram[pass][(bits >> (pass * 8)) & 0xff]++;
+    }
+
+    TArray<T>    valuesTemp;
+    TArray<Bits> keysTemp;
+    valuesTemp.Resize(count);
+    keysTemp.Resize(count);
+
+    T *    srcValues = arr.Ptr();
+    T *    dstValues = valuesTemp.Ptr();
+    Bits * srcKeys   = keys.Ptr();
+    Bits * dstKeys   = keysTemp.Ptr();
+
+    for (uint pass = 0; pass < PASSES; ++pass)
+    {
+        uint * digits = histogram[pass];
+        const uint shift = pass * 8;
+
+        // Every key has the same digit, this pass would not move anything
+        if (digits[(srcKeys[0] >> shift) & 0xff] == count)
+            continue;
+
+        // Exclusive prefix sum gives the first output slot of each digit
+        uint offset = 0;
+        for (uint d = 0; d < 256; ++d)
+        {
+            const uint n = digits[d];
+            digits[d] = offset;
+            offset += n;
+        }
+
+        for (uint i = 0; i < count; ++i)
+        {
+            const uint slot = digits[(srcKeys[i] >> shift) & 0xff]++;
+            dstValues[slot] = std::move(srcValues[i]);
+            dstKeys[slot]   = srcKeys[i];
+        }
+
+        std::swap(srcValues, dstValues);
+        std::swap(srcKeys, dstKeys);
+    }
+
+    // An odd number of effective passes leaves the result in the scratch array
+    if (srcValues != arr.Ptr())
+        std::move(srcValues, srcValues + count, arr.Ptr());
+}
+
+//=============================================================================
+template <typename T, typename C>
+void ParallelMerge (T * src, T * dst, uint count, uint sliceSize, C compare)
+{
+    // Merge adjacent pairs of sorted runs from src into dst, one job per pair
+    Job::CCounter counter;
+    for (uint first = 0; first < count; first += sliceSize * 2)
+    {
+        const uint mid  = Min(first + sliceSize, count);
+        const uint term = Min(first + sliceSize * 2, count);
+        Job::Run([=]() {
+            std::merge(
+                std::make_move_iterator(src + first), std::make_move_iterator(src + mid),
+                std::make_move_iterator(src + mid),   std::make_move_iterator(src + term),
+                dst + first,
+                compare
+            );
+        }, &counter);
+    }
+
+    Job::Wait(&counter);
+}
+
+} // namespace Private
+
+
+
+//*****************************************************************************
+//
+// Sort
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, typename A>
+void Sort (TArray<T, A> & arr)
+{
+    std::sort(arr.begin(), arr.end());
+}
+
+//=============================================================================
+template <typename T, typename A, typename C>
+void Sort (TArray<T, A> & arr, C compare)
+{
+    std::sort(arr.begin(), arr.end(), compare);
+}
+
+//=============================================================================
+template <typename T, typename A, typename F>
+void SortByKey (TArray<T, A> & arr, F key)
+{
+    std::sort(arr.begin(), arr.end(), [&key](const T & lhs, const T & rhs) {
+        return key(lhs) < key(rhs);
+    });
+}
+
+
+
+//*****************************************************************************
+//
+// RadixSort
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, typename A>
+void RadixSort (TArray<T, A> & arr)
+{
+    RadixSort(arr, [](const T & value) { return value; });
+}
+
+//=============================================================================
+template <typename T, typename A, typename F>
+void RadixSort (TArray<T, A> & arr, F key)
+{
+    if (arr.Count() < Private::RADIX_SORT_MIN_COUNT)
+    {
+        // Keep the small case stable to match the radix path
+        typedef typename Private::TRadixKey<typename std::decay<decltype(key(arr[0]))>::type> Radix;
+        std::stable_sort(arr.begin(), arr.end(), [&key](const T & lhs, const T & rhs) {
+            return Radix::Get(key(lhs)) < Radix::Get(key(rhs));
+        });
+        return;
+    }
+
+    Private::RadixSort(arr, key);
+}
+
+
+
+//*****************************************************************************
+//
+// ParallelSort
+//
+//*****************************************************************************
+
+//=============================================================================
+template <typename T, typename A>
+void ParallelSort (TArray<T, A> & arr)
+{
+    ParallelSort(arr, std::less<T>());
+}
+
+//=============================================================================
+template <typename T, typename A, typename C>
+void ParallelSort (TArray<T, A> & arr, C compare)
+{
+    const uint count  = arr.Count();
+    const uint slices = Min(Job::ThreadCount(), count / Private::PARALLEL_SORT_MIN_SLICE);
+    if (slices < 2)
+    {
+        Sort(arr, compare);
+        return;
+    }
+
+    // Sort each slice as its own job
+    uint sliceSize = (count + slices - 1) / slices;
+    {
+        T * data = arr.Ptr();
+        Job::CCounter counter;
+        for (uint first = 0; first < count; first += sliceSize)
+        {
+            const uint term = Min(first + sliceSize, count);
+            Job::Run([=]() { std::sort(data + first, data + term, compare); }, &counter);
+        }
+        Job::Wait(&counter);
+    }
+
+    // Merge runs pairwise, ping-ponging between the array and a scratch copy
+    TArray<T> temp;
+    temp.Resize(count);
+
+    T * src = arr.Ptr();
+    T * dst = temp.Ptr();
+    for (; sliceSize < count; sliceSize *= 2)
+    {
+        Private::ParallelMerge(src, dst, count, sliceSize, compare);
+        std::swap(src, dst);
+    }
+
+    if (src != arr.Ptr())
+        std::move(src, src + count, arr.Ptr());
+}
@@ -1,18 +1,69 @@
 #ifndef UTILITIES_ALLOCATOR_H
 #define UTILITIES_ALLOCATOR_H
 
+#include <atomic>
+
+#include "Basics/Thread.h"
+
 #ifdef BUILD_DEBUG
 #   define BLOCK_ALLOCATOR_VALIDATE
 #endif
 
+//*****************************************************************************
+//
+// AllocatorThreadSlot
+//
+// Small dense index for the calling thread, assigned on first use and handed
+// back when the thread exits, after every allocator has returned that thread's
+// cache to its depot. While all slots are taken, new threads get the slot
+// MAX_SLOTS, which allocators treat as "no private cache".
+//
+//*****************************************************************************
+
+namespace Private
+{
+
+const uint ALLOCATOR_MAX_THREAD_SLOTS = 128;     // One per core on two 64 core sockets
+
+// Allocators with per thread caches register so that exiting threads can
+// flush their cache
+class CAllocatorCaches
+{
+public:
+    virtual void FlushSlot (uint slot) pure;
+};
+
+inline void AllocatorRegister (CAllocatorCaches * allocator);
+inline void AllocatorUnregister (CAllocatorCaches * allocator);
+
+inline uint AllocatorThreadSlot ();
+
+} // namespace Private
+
+
+
 //*****************************************************************************
 //
 // TBlockAllocator
 //
+// Fixed size pool for objects of type T, carved from blocks of Count objects.
+// Safe to use from any number of threads:
+//
+//  - Each thread allocates from and frees into its own cache without locking.
+//  - An empty cache refills a batch of objects from the shared depot, and an
+//    overfull cache returns a batch, so the depot lock is taken once per
+//    batch rather than once per object.
+//  - A thread's cache goes back to the depot when the thread exits.
+//
+// Flush returns every cache that is not in use at that moment to the depot,
+// and Trim then returns blocks whose objects are all back in the depot to the
+// OS. Clear and destruction require that no other thread is using the
+// allocator.
+//
 //*****************************************************************************
 
 template <typename T, uint Count = 16>
-class TBlockAllocator
+class TBlockAllocator : public Private::CAllocatorCaches
 {
 public:
     TBlockAllocator ();
@@ -22,12 +73,24 @@ public:
     void   Free (void * obj);
 
     template <typename... Args>
-    T * New (const Args &... args);
+    T * New (Args &&... args);
     void   Delete (T * obj);
+
+    // Free straight into the depot, bypassing the calling thread's cache. For
+    // threads that free objects from an allocator they never allocate from,
+    // whose cache would only fill up.
+    void   FreeShared (void * obj);
+    void   DeleteShared (T * obj);
+
+    void   Flush ();    // Return every idle cache to the depot
+    uint   Trim ();     // Flush, then free fully unused blocks; returns blocks freed
     void   Clear ();
 	
 private:
+    CLASS_NO_COPY(TBlockAllocator);
+
     static const uint BLOCK_BYTES = sizeof(T) * Count;
+    static const uint BATCH       = Count < 32 ? 32 : Count;
 
     struct FreeObj
     {
@@ -36,21 +99,45 @@ private:
 
     struct Block
     {
-        Block * next;
-        byte    objects[BLOCK_BYTES];
+        Block *             next;
+        alignas(T) byte     objects[BLOCK_BYTES];
+
+        void * operator new (size_t bytes) { return MemAllocAligned(uint(bytes), alignof(Block)); }
+        void   operator delete (void * ptr) { MemFreeAligned(ptr, alignof(Block)); }
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Cache
+    {
+        FreeObj *         list  = null;
+        uint              count = 0;
+        std::atomic<bool> busy  = {false};    // Held by the owner while in use, or by Flush
     };
 
-    Block   * m_blockList = null;
-    FreeObj * m_objList = null;
+    // Per thread caches. Only the owning thread allocates from its cache;
+    // Flush may empty any cache that is not busy.
+    Cache     m_caches[Private::ALLOCATOR_MAX_THREAD_SLOTS];
+
+    // Shared depot
+    Lockable  m_lock;
+    Block *   m_blockList = null;
+    FreeObj * m_objList   = null;
+    uint      m_objCount  = 0;
 #ifdef BLOCK_ALLOCATOR_VALIDATE
-    uint      m_allocCount = 0;
+    std::atomic<sint> m_allocCount;
 #endif
 
-    void Grow ();
+    Cache * LockCache (uint slot);
+    void    UnlockCache (Cache * cache);
+    void    Refill (Cache * cache);
+    void    Release (Cache * cache, uint count);
+    void    Drain (Cache * cache);  // Under m_lock
+    void    Grow ();
+
+    void    FlushSlot (uint slot) override;
 
     static_assert(sizeof(T) >= sizeof(FreeObj), "Cannot use block allocators on small types");
 };
 
 #include "Allocator/Allocator.inl"
 
-#endif // UTILITIES_ALLOCATOR_H
\ No newline at end of file
+#endif // UTILITIES_ALLOCATOR_H
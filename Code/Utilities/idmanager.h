@@ -17,6 +17,8 @@ public:
     inline TId & operator++ ();
     inline TId & operator++ (int);
 
+    inline T GetRaw () const;
+
     template <typename Tag, typename T> friend bool operator== (TId<Tag, T>, TId<Tag, T>);
     template <typename Tag, typename T> friend bool operator!= (TId<Tag, T>, TId<Tag, T>);
     template <typename Tag, typename T> friend bool operator<  (TId<Tag, T>, TId<Tag, T>);
@@ -40,6 +42,13 @@ template <typename Tag, typename T> inline bool operator<= (TId<Tag, T> lhs, TId
 template <typename Tag, typename T> inline bool operator>  (TId<Tag, T> lhs, TId<Tag, T> rhs);
 template <typename Tag, typename T> inline bool operator>= (TId<Tag, T> lhs, TId<Tag, T> rhs);
 
+// Lets ids be stored in a TSparseSet
+template <typename Tag, typename T>
+struct TSparseSetIndex<TId<Tag, T>>
+{
+    static uint Get (const TId<Tag, T> & key) { return uint(key.GetRaw()); }
+};
+
 
 
 //*****************************************************************************
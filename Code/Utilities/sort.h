@@ -0,0 +1,64 @@
+#ifndef UTILITIES_SORT_H
+#define UTILITIES_SORT_H
+
+#include "Basics/Job.h"
+
+//*****************************************************************************
+//
+// Sort
+//
+// Comparison sorts over a TArray. The key versions order elements by the
+// value key(element) returns, compared with operator<.
+//
+//*****************************************************************************
+
+template <typename T, typename A>
+void Sort (TArray<T, A> & arr);
+
+template <typename T, typename A, typename C>
+void Sort (TArray<T, A> & arr, C compare);
+
+template <typename T, typename A, typename F>
+void SortByKey (TArray<T, A> & arr, F key);
+
+
+
+//*****************************************************************************
+//
+// RadixSort
+//
+// Stable LSD radix sort, eight bits per pass, for integer and floating point
+// keys. Passes in which every key has the same digit are skipped, so narrow
+// key ranges cost fewer passes. Floats sort in IEEE total order, with -0 before
+// +0 and NaNs at the ends. Needs scratch space for a copy of the array and its
+// keys. Small arrays fall back to a stable comparison sort.
+//
+//*****************************************************************************
+
+template <typename T, typename A>
+void RadixSort (TArray<T, A> & arr);
+
+template <typename T, typename A, typename F>
+void RadixSort (TArray<T, A> & arr, F key);
+
+
+
+//*****************************************************************************
+//
+// ParallelSort
+//
+// Sorts equal slices of the array as jobs, then merges them pairwise, also as
+// jobs. Not stable. Falls back to Sort for arrays too small to be worth
+// splitting, or when the job system has no workers.
+//
+//*****************************************************************************
+
+template <typename T, typename A>
+void ParallelSort (TArray<T, A> & arr);
+
+template <typename T, typename A, typename C>
+void ParallelSort (TArray<T, A> & arr, C compare);
+
+#include "Sort/Sort.inl"
+
+#endif // UTILITIES_SORT_H
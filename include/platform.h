@@ -21,7 +21,7 @@ namespace fe {
 #elif defined(__arm__) || defined(__aarch64__) || defined(_M_ARM)
 #	undef  FE_ARCH_ARM
 #	define FE_ARCH_ARM 1
-#elif defined(__ia64__) || defined(_M_IA64)
+#elif defined(__x86_64__) || defined(_M_X64)
 #	undef  FE_ARCH_X64
 #	define FE_ARCH_X64 1
 #elif defined(__powerpc__) || defined(_M_PPC)
@@ -41,7 +41,7 @@ namespace fe {
 #define FE_BITS_32 0
 #define FE_BITS_64 0
 
-#if defined(__aarch64__) || defined(__ia64__)
+#if defined(__aarch64__) || defined(__x86_64__) || defined(_M_X64) || defined(_M_ARM64)
 #   undef  FE_BITS_64
 #   define FE_BITS_64 1
 #else
@@ -74,7 +74,7 @@ namespace fe {
 #if defined(_WIN32)
 #	undef  FE_OS_WINDOWS
 #	define FE_OS_WINDOWS 1
-#elif define(__linux__)
+#elif defined(__linux__)
 #	undef  FE_OS_LINUX
 #	define FE_OS_LINUX 1
 #elif defined(__ANDROID__)
@@ -109,7 +109,7 @@ namespace fe {
 #	define FE_COMPILER_MSVC _MSC_VER
 #elif defined(__clang__)
 #	undef  FE_COMPILER_CLANG
-#	define FE_COMPILER_CLANG FE_COMPILER_CLANG_VERSION(__clang_major__, __clang_minor__)
+#	define FE_COMPILER_CLANG FE_COMPILER_VERSION_CLANG(__clang_major__, __clang_minor__)
 #elif defined(__GNUC__)
 #	undef  FE_COMPILER_GCC
 #	define FE_COMPILER_GCC FE_COMPILER_VERSION_GCC(__GNUC__, __GNUC_MINOR__)
@@ -152,4 +152,30 @@ namespace fe {
 #define FE_LANGUAGE_CPP 0
 #define FE_LANGUAGE_CLI 0
 
+
+
+//*****************************************************************************
+//
+// FE_THREAD_*
+//
+// Threading backend used by Basics/Thread. Win32 on Windows and POSIX
+// everywhere else. The POSIX backend waits on futexes, so it only builds on
+// Linux for now.
+//
+//*****************************************************************************
+
+#ifndef FE_THREAD_POSIX
+#	if FE_OS_WINDOWS
+#		define FE_THREAD_POSIX 0
+#	else
+#		define FE_THREAD_POSIX 1
+#	endif
+#endif
+
+#if FE_THREAD_POSIX
+#	define FE_THREAD_WIN32 0
+#else
+#	define FE_THREAD_WIN32 1
+#endif
+
 } // namespace fe
\ No newline at end of file
@@ -15,6 +15,9 @@ project "Ferrite"
         --"./Code/External/bgfx/tools/**",
         --"./Code/External/bgfx/3rdparty/**",
     }
+    includedirs {
+        "./include",
+    }
     --includedirs {
     --    "./Code/External/bx/**",
     --    "./Code/External/bgfx/**",